@@ -24,10 +24,15 @@ namespace aos {
   // Constante para convertir grados a radianes
   constexpr double DEGREES_TO_RADIANS = M_PI / 180.0;
 
-  class Camera {
+  // CÁMARA QUE GENERA RAYOS DE ESCALAR T (Camera es la de double); la base se calcula en double y
+  // se convierte a T al final
+  template <typename T>
+  class BasicCamera {
   public:
+    using vector_type = VectorOf<T>;
+
     // Constructor que se inicializa a partir de los parámetros de configuración
-    Camera(ConfigParams const & config) {
+    BasicCamera(ConfigParams const & config) {
       // Posición y orientación de la cámara
       auto lookfrom = PointVector(config.camera_x, config.camera_y, config.camera_z);
       auto lookat   = PointVector(config.target_x, config.target_y, config.target_z);
@@ -41,31 +46,35 @@ namespace aos {
       auto viewport_w   = aspect_ratio * viewport_h;
 
       // Cálculo de la base ortonormal de la cámara (ejes W, U, V)
-      w = unit_vector(lookfrom - lookat);
-      u = unit_vector(cross(vup, w));
-      v = cross(w, u);
+      Vector const w = unit_vector(lookfrom - lookat);
+      Vector const u = unit_vector(cross(vup, w));
+      Vector const v = cross(w, u);
 
       // Configuración final
-      origin            = lookfrom;
-      horizontal        = viewport_w * u;
-      vertical          = viewport_h * v;
-      lower_left_corner = origin - (horizontal / 2.0) - (vertical / 2.0) - w;
+      Vector const horizontal_d = viewport_w * u;
+      Vector const vertical_d   = viewport_h * v;
+      Vector const corner       = lookfrom - (horizontal_d / 2.0) - (vertical_d / 2.0) - w;
+      origin                    = render::vector_cast<T>(lookfrom);
+      lower_left_corner         = render::vector_cast<T>(corner);
+      horizontal                = render::vector_cast<T>(horizontal_d);
+      vertical                  = render::vector_cast<T>(vertical_d);
     }
 
     // Genera un rayo para un píxel (s, t) en la pantalla
-    [[nodiscard]] Ray get_ray(double s, double t) const {
-      DirectionVector dir = lower_left_corner + s * horizontal + t * vertical - origin;
+    [[nodiscard]] BasicRay<T> get_ray(T s, T t) const {
+      vector_type dir = lower_left_corner + s * horizontal + t * vertical - origin;
       return {origin, unit_vector(dir)};
     }
 
   private:
-    PointVector origin;
-    PointVector lower_left_corner;
-    DirectionVector horizontal;
-    DirectionVector vertical;
-    DirectionVector u, v, w;  // Base ortonormal de la cámara
+    vector_type origin;
+    vector_type lower_left_corner;
+    vector_type horizontal;
+    vector_type vertical;
   };
 
+  using Camera = BasicCamera<double>;
+
 }  // namespace aos
 
 #endif  // AOS_CAMERA_HPP
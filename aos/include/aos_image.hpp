@@ -2,6 +2,8 @@
 #define AOS_IMAGE_HPP
 
 #include "aos_vector.hpp"
+#include "tone_mapping.hpp"
+#include <cstdint>
 #include <vector>
 
 namespace aos {
@@ -18,6 +20,8 @@ namespace aos {
 
     // Funciones principales
     void set_pixel(int x, int y, ColorVector const & color);
+    // Fila completa de color lineal: clamp, gamma y cuantización con la tabla 'lut'
+    void set_row(int y, render::LinearRow const & row, render::GammaLUT const & lut);
     void write_ppm(std::ostream & out) const;
 
     // Getters
@@ -29,6 +33,8 @@ namespace aos {
     int width_;
     int height_;
     std::vector<Pixel> pixels_;
+    // canales cuantizados de la fila de set_row antes de intercalarlos (reservados al construir)
+    std::vector<std::uint8_t> red_row_, green_row_, blue_row_;
   };
 
 }  // namespace aos
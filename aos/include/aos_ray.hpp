@@ -2,26 +2,15 @@
 #define AOS_RAY_HPP
 
 #include "aos_vector.hpp"
+#include "ray.hpp"
 
 namespace aos {
 
-  class Ray {
-  public:
-    // Constructores
-    Ray();
-    Ray(PointVector const & origin, DirectionVector const & direction);
+  // el rayo de common, como el vector (aos_vector.hpp)
+  template <typename T>
+  using BasicRay = render::basic_ray<T>;
 
-    // Getters
-    [[nodiscard]] PointVector get_origin() const;
-    [[nodiscard]] DirectionVector get_direction() const;
-
-    // Funciones
-    [[nodiscard]] PointVector at(double t) const;
-
-  private:
-    PointVector orig;
-    DirectionVector dir;
-  };
+  using Ray = render::ray;
 
 }  // namespace aos
 
@@ -0,0 +1,20 @@
+#ifndef AOS_RENDERER_HPP
+#define AOS_RENDERER_HPP
+
+#include "renderer.hpp"
+
+#include <cstdint>
+
+namespace aos {
+
+  // Backend AOS: trazador rayo a rayo sobre render::hittable_list, fila a fila y con render
+  // completo, progresivo (--progressive), con presupuesto de tiempo (--time-budget) y reanudable
+  // desde un checkpoint (--resume)
+  class AOSRenderer : public render::Renderer {
+  public:
+    bool render(render::RenderJob const & job, std::uint64_t & primary_rays) override;
+  };
+
+}  // namespace aos
+
+#endif  // AOS_RENDERER_HPP
@@ -1,42 +1,21 @@
 #ifndef AOS_VECTOR_HPP
 #define AOS_VECTOR_HPP
 
-#include <cmath>
-#include <iostream>
+#include "vector.hpp"
 
 namespace aos {
 
-  class Vector {
-  public:
-    // Constructores
-    Vector();
-    Vector(double cx, double cy, double cz);
-
-    // Getters
-    [[nodiscard]] double get_x() const;
-    [[nodiscard]] double get_y() const;
-    [[nodiscard]] double get_z() const;
-    [[nodiscard]] double r() const;
-    [[nodiscard]] double g() const;
-    [[nodiscard]] double b() const;
-
-    // Operadores
-    Vector operator-() const;
-    double operator[](int i) const;
-    double & operator[](int i);
-    Vector & operator+=(Vector const & v);
-    Vector & operator-=(Vector const & v);
-    Vector & operator*=(double t);
-    Vector & operator/=(double t);
-
-    // Magnitudes
-    [[nodiscard]] double magnitude_squared() const;
-    [[nodiscard]] double magnitude() const;
-    [[nodiscard]] bool near_zero() const;
-
-  private:
-    double x, y, z;
-  };
+  // AOS usa el vector de common (render::basic_vector, con la disposición de la opción
+  // RENDER_VECTOR_PADDED): la geometría y los materiales de common trabajan sobre los mismos
+  // vectores que el bucle de render, sin conversiones
+  template <typename T>
+  using VectorOf = render::basic_vector<T>;
+
+  using Vector = render::vector;
+
+  using render::cross;
+  using render::dot;
+  using render::unit_vector;
 
   // Alias
   using PointVector     = Vector;
@@ -44,18 +23,6 @@ namespace aos {
   using DirectionVector = Vector;
   using NormalVector    = Vector;
 
-  // Declaraciones de funciones (implementación en .cpp)
-  std::ostream & operator<<(std::ostream & out, Vector const & v);
-  Vector operator+(Vector const & u, Vector const & v);
-  Vector operator-(Vector const & u, Vector const & v);
-  Vector operator*(Vector const & u, Vector const & v);
-  Vector operator*(double t, Vector const & v);
-  Vector operator*(Vector const & v, double t);
-  Vector operator/(Vector const & v, double t);
-  double dot(Vector const & u, Vector const & v);
-  Vector cross(Vector const & u, Vector const & v);
-  Vector unit_vector(Vector const & v);
-
 }  // namespace aos
 
 #endif  // AOS_VECTOR_HPP
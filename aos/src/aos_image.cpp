@@ -1,6 +1,7 @@
 #include <cstddef>
 
 #include "../include/aos_image.hpp"
+#include "trace.hpp"
 
 namespace aos {
 
@@ -12,23 +13,39 @@ namespace aos {
 
   // AOSImage
   AOSImage::AOSImage(int width, int height)
-      : width_(width), height_(height), pixels_(static_cast<size_t>(width * height)) { }
+      : width_(width), height_(height), pixels_(static_cast<size_t>(width * height)),
+        red_row_(static_cast<size_t>(width)), green_row_(static_cast<size_t>(width)),
+        blue_row_(static_cast<size_t>(width)) { }
 
   void AOSImage::set_pixel(int x, int y, ColorVector const & color) {
-    int index        = y * width_ + x;
+    auto index       = static_cast<std::size_t>(y * width_ + x);
     pixels_[index].r = static_cast<unsigned char>(color.r() * 255);
     pixels_[index].g = static_cast<unsigned char>(color.g() * 255);
     pixels_[index].b = static_cast<unsigned char>(color.b() * 255);
   }
 
+  void AOSImage::set_row(int y, render::LinearRow const & row, render::GammaLUT const & lut) {
+    // Cuantizamos cada canal por separado (bucles vectorizables) y luego intercalamos
+    std::size_t const width = static_cast<std::size_t>(width_);
+    lut.quantize(row.r.first(width), red_row_);
+    lut.quantize(row.g.first(width), green_row_);
+    lut.quantize(row.b.first(width), blue_row_);
+
+    std::size_t const base = static_cast<std::size_t>(y) * width;
+    for (std::size_t x = 0; x < width; ++x) {
+      pixels_[base + x] = Pixel(red_row_[x], green_row_[x], blue_row_[x]);
+    }
+  }
+
   void AOSImage::write_ppm(std::ostream & out) const {
+    render::ScopedTimer const timer("write_ppm", "io");
     // Cabecera PPM
     out << "P3\n" << width_ << ' ' << height_ << "\n255\n";
 
     // Datos de píxeles
     for (int y = height_ - 1; y >= 0; --y) {
       for (int x = 0; x < width_; ++x) {
-        int index = y * width_ + x;
+        auto index = static_cast<std::size_t>(y * width_ + x);
         out << static_cast<int>(pixels_[index].r) << ' ' << static_cast<int>(pixels_[index].g)
             << ' ' << static_cast<int>(pixels_[index].b) << '\n';
       }
@@ -0,0 +1,586 @@
+#include "../include/aos_renderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+// --- Includes de AOS ---
+#include "aos_camera.hpp"
+#include "aos_image.hpp"
+#include "aos_ray.hpp"     // render::ray de common
+#include "aos_vector.hpp"  // render::vector de common
+
+// --- Includes de Common ---
+#include "accumulation_buffer.hpp"
+#include "checkpoint.hpp"
+#include "cli_options.hpp"
+#include "config.hpp"
+#include "cost_map.hpp"
+#include "hittable.hpp"
+#include "material_base.hpp"
+#include "material_logic.hpp"
+#include "materials.hpp"
+#include "math_utilities.hpp"
+#include "objects.hpp"
+#include "progress_reporter.hpp"
+#include "render_stats.hpp"
+#include "running_stats.hpp"
+#include "sampler.hpp"
+#include "scene_parser.hpp"
+#include "snapshot_writer.hpp"
+#include "tone_mapping.hpp"
+#include "trace.hpp"
+
+namespace {
+
+  // --- Constantes ---
+  constexpr double T_MIN = 0.001;
+  constexpr double T_MAX = std::numeric_limits<double>::infinity();
+
+  // --- Función Ray-Color (Lógica principal de renderizado) ---
+
+  /**
+   * @brief Calcula el color de fondo (cielo)
+   */
+  aos::ColorVector background_color(aos::Ray const & r, ConfigParams const & config) {
+    aos::DirectionVector unit_direction = aos::unit_vector(r.dir);
+    // Mapea el componente 'y' de -1.0 a 1.0 -> 0.0 a 1.0
+    auto t = 0.5 * (unit_direction.get_y() + 1.0);
+
+    // Colores base del cielo
+    aos::ColorVector light(config.background_light_color_r, config.background_light_color_g,
+                           config.background_light_color_b);
+    aos::ColorVector dark(config.background_dark_color_r, config.background_dark_color_g,
+                          config.background_dark_color_b);
+
+    // Interpolación lineal (lerp) entre claro y oscuro, igual que color::background_color de SOA:
+    // claro hacia -y, oscuro hacia +y
+    return (1.0 - t) * light + t * dark;
+  }
+
+  /**
+   * @brief Función recursiva que calcula el color de un rayo
+   */
+  aos::ColorVector ray_color(aos::Ray const & r, render::hittable const & world,
+                             ConfigParams const & config, render::SampleStream & samples,
+                             int depth) {
+    // Si alcanzamos el límite de rebotes, no más luz
+    if (depth <= 0) {
+      RENDER_STAT(++render::thread_stats().max_depth_terminations);
+      return aos::ColorVector(0.0, 0.0, 0.0);
+    }
+    RENDER_STAT(render::thread_stats().count_ray(config.max_depth - depth));
+
+    render::hit_record rec;
+
+    // Comprobamos la colisión los objetos de la escena (aos::Ray es render::ray: sin conversiones)
+    if (world.hit(r, T_MIN, T_MAX, rec)) {
+      RENDER_STAT(++render::thread_stats().ray_hits);
+      aos::Ray scattered;
+      aos::ColorVector attenuation;
+
+      // Preparamos la estructura de E/S para la lógica de materiales
+      render::ScatterIO scatter_io{};
+      scatter_io.attenuation   = &attenuation;
+      scatter_io.scattered     = &scattered;
+      scatter_io.samples       = &samples;
+      scatter_io.matte_scatter = config.matte_scatter;
+
+      // Llamamos a la lógica de dispersión
+      if (render::scatter(r, rec, scatter_io)) {
+        // El rayo rebotó: seguimos con el rayo dispersado
+        return attenuation * ray_color(scattered, world, config, samples, depth - 1);
+      }
+
+      // El material absorbió el rayo
+      return aos::ColorVector(0.0, 0.0, 0.0);
+    }
+
+    // Si no hay colisión, devolvemos el color del cielo
+    RENDER_STAT(++render::thread_stats().ray_misses);
+    return background_color(r, config);
+  }
+
+  // --- Preparación de la Escena ---
+
+  /**
+   * @brief Crea los parámetros de la cámara AOS a partir de la configuración común
+   */
+  aos::ConfigParams camera_config(ConfigParams const & config) {
+    aos::ConfigParams aos_config{};
+    aos_config.camera_x      = config.camera_x;
+    aos_config.camera_y      = config.camera_y;
+    aos_config.camera_z      = config.camera_z;
+    aos_config.target_x      = config.target_x;
+    aos_config.target_y      = config.target_y;
+    aos_config.target_z      = config.target_z;
+    aos_config.north_x       = config.north_x;
+    aos_config.north_y       = config.north_y;
+    aos_config.north_z       = config.north_z;
+    aos_config.field_of_view = config.field_of_view;
+    aos_config.aspect_width  = config.aspect_width;
+    aos_config.aspect_height = config.aspect_height;
+    return aos_config;
+  }
+
+  // --- Renderizado ---
+
+  /**
+   * @brief Datos de solo lectura compartidos por todo el render
+   */
+  struct RenderContext {
+    ConfigParams const * config;
+    render::hittable const * world;
+    aos::Camera const * camera;
+    render::Sampler const * sampler;
+  };
+
+  /**
+   * @brief Estado del render que se guarda en los checkpoints
+   */
+  struct RenderState {
+    render::AccumulationBuffer buffer;
+    render::RNG ray_rng;
+    render::RNG material_rng;
+    std::int64_t completed_rows = 0;
+    // coste de cada píxel (--heatmap) e indicador de progreso; no se guardan en los checkpoints
+    std::optional<render::CostMap> cost_map{};
+    render::ProgressReporter * progress = nullptr;
+
+    [[nodiscard]] render::CheckpointData checkpoint_data(ConfigParams const & config) {
+      return {&config, &buffer, &ray_rng, &material_rng, completed_rows};
+    }
+  };
+
+  /**
+   * @brief Traza la muestra point.index del píxel (point.x, point.y): rayo de cámara con un offset
+   * dentro del píxel. Con sampler random el offset sale de ray_rng y los rebotes de material_rng;
+   * con las demás secuencias ambos son dimensiones consecutivas del mismo punto
+   */
+  aos::ColorVector trace_sample(RenderContext const & ctx, render::SamplePoint const & point,
+                                RenderState & state) {
+    ConfigParams const & config = *ctx.config;
+    int const image_width       = config.image_width;
+    int const image_height      = config.get_image_height();
+    bool const random           = ctx.sampler->type() == SamplerType::RANDOM;
+    render::SampleStream pixel_samples = random ? render::SampleStream(state.ray_rng)
+                                                : render::SampleStream(*ctx.sampler, point);
+
+    // Coordenadas (u, v) del píxel actual, con un offset aleatorio
+    auto u = (static_cast<double>(point.x) + pixel_samples.next()) / (image_width - 1);
+    auto v = (static_cast<double>(point.y) + pixel_samples.next()) / (image_height - 1);
+
+    // Obtenemos rayo de la cámara AOS y calculamos su color
+    aos::Ray r = ctx.camera->get_ray(u, v);
+    render::SampleStream bounce_samples = random ? render::SampleStream(state.material_rng)
+                                                 : pixel_samples;
+    return ray_color(r, *ctx.world, config, bounce_samples, config.max_depth);
+  }
+
+  /**
+   * @brief Suma de las muestras tomadas en un píxel y cuántas fueron
+   */
+  struct PixelSamples {
+    aos::ColorVector sum;
+    std::uint32_t count = 0;
+  };
+
+  /**
+   * @brief Toma las muestras del píxel (i, j): samples_per_pixel fijas o, en modo adaptativo,
+   * entre adaptive_min_samples y adaptive_max_samples según la varianza estimada (Welford)
+   */
+  PixelSamples sample_pixel(RenderContext const & ctx, int i, int j, RenderState & state) {
+    ConfigParams const & config = *ctx.config;
+    PixelSamples pixel;
+
+    // --- Bucle de Anti-Aliasing (múltiples muestras por píxel) ---
+    if (!config.adaptive_sampling()) {
+      for (int s = 0; s < config.samples_per_pixel; ++s) {
+        pixel.sum += trace_sample(ctx, {.x = i, .y = j, .index = static_cast<std::uint32_t>(s)},
+                                  state);
+      }
+      pixel.count = static_cast<std::uint32_t>(config.samples_per_pixel);
+      return pixel;
+    }
+
+    // --- Muestreo adaptativo: se para cuando el error estimado baja del umbral ---
+    render::RunningStats stats;
+    while (pixel.count < static_cast<std::uint32_t>(config.adaptive_max_samples)) {
+      aos::ColorVector const sample =
+          trace_sample(ctx, {.x = i, .y = j, .index = pixel.count}, state);
+      pixel.sum                    += sample;
+      ++pixel.count;
+      stats.add(render::luminance(sample));
+      if (pixel.count >= static_cast<std::uint32_t>(config.adaptive_min_samples) and
+          stats.converged(config.adaptive_threshold))
+      {
+        break;
+      }
+    }
+    return pixel;
+  }
+
+  /**
+   * @brief Renderiza la fila j (j = 0 es la fila inferior de la imagen)
+   * @return Muestras trazadas en la fila
+   */
+  std::uint64_t render_row(RenderContext const & ctx, int j, RenderState & state) {
+    render::ScopedTimer const timer("row", "render", j);
+    int const image_width  = ctx.config->image_width;
+    int const image_height = ctx.config->get_image_height();
+
+    // --- Bucle de píxeles (de izquierda a derecha) ---
+    std::uint64_t samples = 0;
+    for (int i = 0; i < image_width; ++i) {
+      // Guardamos la suma en el buffer (nota: coordenada Y invertida para almacenamiento). Se
+      // añade de una vez para conservar la suma exacta del bucle de muestras
+      std::uint64_t const cost_start = state.cost_map ? state.cost_map->probe() : 0;
+      PixelSamples const pixel       = sample_pixel(ctx, i, j, state);
+      state.buffer.add_samples(i, image_height - 1 - j, pixel.sum, pixel.count);
+      if (state.cost_map) {
+        state.cost_map->add(i, image_height - 1 - j, cost_start);
+      }
+      samples += pixel.count;
+    }
+    return samples;
+  }
+
+  /**
+   * @brief Renderiza las filas pendientes guardando checkpoints periódicos
+   */
+  bool render_image(RenderContext const & ctx, RenderOptions const & options, RenderState & state) {
+    using clock            = std::chrono::steady_clock;
+    int const image_height = ctx.config->get_image_height();
+    auto const interval    = std::chrono::duration<double>(options.checkpoint_interval);
+    auto last_checkpoint   = clock::now();
+    bool const checkpoints = options.checkpoint_interval > 0;
+
+    // --- Bucle principal de renderizado (de arriba abajo) ---
+    while (state.completed_rows < image_height) {
+      int const j = image_height - 1 - static_cast<int>(state.completed_rows);
+      std::uint64_t const samples = render_row(ctx, j, state);
+      ++state.completed_rows;
+      state.progress->advance(1, samples);
+
+      if (checkpoints and state.completed_rows < image_height and
+          clock::now() - last_checkpoint >= interval)
+      {
+        if (!render::save_checkpoint(options.checkpoint_path(), state.checkpoint_data(*ctx.config)))
+        {
+          return false;
+        }
+        last_checkpoint = clock::now();
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Pasada completa sobre la imagen: añade 'samples' muestras a cada píxel
+   */
+  void render_pass(RenderContext const & ctx, int samples, RenderState & state) {
+    render::ScopedTimer const timer("pass", "render", samples);
+    int const image_width  = ctx.config->image_width;
+    int const image_height = ctx.config->get_image_height();
+    for (int j = image_height - 1; j >= 0; --j) {
+      for (int i = 0; i < image_width; ++i) {
+        std::uint64_t const cost_start = state.cost_map ? state.cost_map->probe() : 0;
+        // la pasada continúa la secuencia del píxel donde la dejó la anterior
+        std::uint32_t const first = state.buffer.sample_count(i, image_height - 1 - j);
+        aos::ColorVector sum;
+        for (int s = 0; s < samples; ++s) {
+          sum += trace_sample(
+              ctx, {.x = i, .y = j, .index = first + static_cast<std::uint32_t>(s)}, state);
+        }
+        state.buffer.add_samples(i, image_height - 1 - j, sum, static_cast<std::uint32_t>(samples));
+        if (state.cost_map) {
+          state.cost_map->add(i, image_height - 1 - j, cost_start);
+        }
+      }
+      state.progress->advance(1, static_cast<std::uint64_t>(image_width) *
+                                     static_cast<std::uint64_t>(samples));
+    }
+  }
+
+  /**
+   * @brief Indica si toca escribir una imagen intermedia tras 'passes' pasadas
+   */
+  bool snapshot_due(RenderOptions const & options, int passes,
+                    std::chrono::steady_clock::duration since_last) {
+    if (options.snapshot_every > 0 and passes % options.snapshot_every == 0) {
+      return true;
+    }
+    return options.snapshot_interval > 0 and
+           since_last >= std::chrono::duration<double>(options.snapshot_interval);
+  }
+
+  /**
+   * @brief Render progresivo por pasadas. Sin presupuesto de tiempo se para al llegar a
+   * samples_per_pixel; con él, cuando la siguiente pasada ya no cabe antes de 'deadline'
+   * (estimando su duración por la de la anterior). Siempre se hace al menos una pasada para que la
+   * imagen tenga contenido. Con --progressive las imágenes intermedias se escriben en otro hilo
+   * @return Muestras por píxel alcanzadas
+   */
+  int render_progressive(RenderContext const & ctx, RenderOptions const & options,
+                         std::chrono::steady_clock::time_point deadline, RenderState & state) {
+    using clock      = std::chrono::steady_clock;
+    bool const timed = options.time_budget > 0;
+    int const target = timed ? std::numeric_limits<int>::max() : ctx.config->samples_per_pixel;
+    std::optional<render::SnapshotWriter> snapshots;
+    if (options.progressive) {
+      snapshots.emplace(options.snapshot_path(), ctx.config->gamma, true);
+    }
+
+    int samples        = 0;
+    int passes         = 0;
+    auto last_snapshot = clock::now();
+    while (samples < target) {
+      auto const pass_start = clock::now();
+      int const pass        = std::min(options.pass_samples, target - samples);
+      render_pass(ctx, pass, state);
+      samples += pass;
+      ++passes;
+      auto const now = clock::now();
+      if (snapshots and snapshot_due(options, passes, now - last_snapshot)) {
+        snapshots->submit(state.buffer);
+        last_snapshot = now;
+      }
+      if (timed and now + (now - pass_start) > deadline) {
+        break;
+      }
+    }
+    return samples;
+  }
+
+  /**
+   * @brief Filas que renderizará el modo elegido, para el indicador de progreso: las pendientes o
+   * las de todas las pasadas (0 = desconocido con presupuesto de tiempo)
+   */
+  std::uint64_t progress_total(RenderOptions const & options, ConfigParams const & config,
+                               RenderState const & state) {
+    auto const rows = static_cast<std::uint64_t>(config.get_image_height());
+    if (options.time_budget > 0) {
+      return 0;
+    }
+    if (options.progressive) {
+      auto const pass_samples = static_cast<std::uint64_t>(options.pass_samples);
+      auto const target       = static_cast<std::uint64_t>(config.samples_per_pixel);
+      return rows * ((target + pass_samples - 1) / pass_samples);
+    }
+    return rows - static_cast<std::uint64_t>(state.completed_rows);
+  }
+
+  /**
+   * @brief Restaura el estado desde el checkpoint si se pidió --resume y existe
+   */
+  bool resume_state(RenderOptions const & options, ConfigParams const & config,
+                    RenderState & state) {
+    std::string const path = options.checkpoint_path();
+    if (!options.resume) {
+      return true;
+    }
+    if (!std::filesystem::exists(path)) {
+      std::cerr << "No hay checkpoint en " << path << "; se renderiza desde el principio.\n";
+      return true;
+    }
+    render::CheckpointData data = state.checkpoint_data(config);
+    if (!render::load_checkpoint(path, data)) {
+      return false;
+    }
+    if (data.progress < 0 or data.progress > config.get_image_height()) {
+      std::cerr << "Error: Progreso inválido en el checkpoint " << path << '\n';
+      return false;
+    }
+    state.completed_rows = data.progress;
+    std::cerr << "Reanudando desde " << path << " (" << state.completed_rows
+              << " filas completadas)\n";
+    return true;
+  }
+
+  /**
+   * @brief Promedia, aplica corrección gamma y guarda cada fila en la imagen AOS
+   */
+  void finalise_image(ConfigParams const & config, render::AccumulationBuffer const & buffer,
+                      aos::AOSImage & image) {
+    render::ScopedTimer const timer("tone_mapping", "output");
+    // La corrección gamma usa la tabla de render::GammaLUT en lugar de std::pow por canal
+    render::GammaLUT const lut(config.gamma);
+    auto const width = static_cast<std::size_t>(buffer.width());
+    std::vector<double> r_row(width);
+    std::vector<double> g_row(width);
+    std::vector<double> b_row(width);
+    for (int y = 0; y < buffer.height(); ++y) {
+      buffer.row_average(y, r_row, g_row, b_row);
+      image.set_row(y, render::LinearRow{r_row, g_row, b_row}, lut);
+    }
+  }
+
+  // --- Preparación del Render ---
+
+  /**
+   * @brief Añade todos los objetos de la escena a la lista 'world'
+   */
+  void build_world(SceneOutput const & scene, render::hittable_list & world) {
+    render::ScopedTimer const timer("build_world", "setup");
+    for (auto const & sph : scene.spheres.get()) {
+      world.add(&sph);
+    }
+    for (auto const & cyl : scene.cylinders.get()) {
+      world.add(&cyl);
+    }
+  }
+
+  /**
+   * @brief Escribe en std::cerr el modo de render y sus parámetros
+   */
+  void print_header(RenderOptions const & options, ConfigParams const & config) {
+    std::cerr << "Renderizando AOS... (Ancho=" << config.image_width
+              << ", Alto=" << config.get_image_height();
+    bool const by_passes = options.progressive or options.time_budget > 0;
+    if (options.time_budget > 0) {
+      std::cerr << ", Presupuesto=" << options.time_budget << " s)\n";
+    } else if (options.progressive) {
+      std::cerr << ", Muestras=" << config.samples_per_pixel
+                << ", Muestras por pasada=" << options.pass_samples << ")\n";
+    } else if (config.adaptive_sampling()) {
+      std::cerr << ", Muestras adaptativas=" << config.adaptive_min_samples << "-"
+                << config.adaptive_max_samples << ", Umbral=" << config.adaptive_threshold
+                << ")\n";
+    } else {
+      std::cerr << ", Muestras=" << config.samples_per_pixel << ")\n";
+    }
+    if (by_passes and config.adaptive_sampling()) {
+      std::cerr << "Aviso: adaptivesampling se ignora en el render por pasadas\n";
+    }
+  }
+
+  /**
+   * @brief Renderiza en el modo que piden las opciones: presupuesto de tiempo, progresivo o
+   * completo (fila a fila, con checkpoints)
+   */
+  bool run_mode(RenderContext const & ctx, RenderOptions const & options,
+                std::chrono::steady_clock::time_point start_time, RenderState & state) {
+    if (options.time_budget > 0) {
+      // --- Modo con presupuesto de tiempo: pasadas completas hasta agotar el tiempo ---
+      auto const budget = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(options.time_budget));
+      int const samples = render_progressive(ctx, options, start_time + budget, state);
+      state.progress->finish();
+
+      std::chrono::duration<double> const used = std::chrono::steady_clock::now() - start_time;
+      std::cerr << "Presupuesto de tiempo: " << options.time_budget
+                << " s, usado: " << used.count()
+                << " s, muestras por píxel alcanzadas: " << samples << '\n';
+      return true;
+    }
+    if (options.progressive) {
+      // --- Modo progresivo: pasadas hasta samples_per_pixel con imágenes intermedias ---
+      (void) render_progressive(ctx, options, std::chrono::steady_clock::time_point::max(),
+                                state);
+      state.progress->finish();
+      std::cerr << "Última imagen intermedia en: " << options.snapshot_path() << '\n';
+      return true;
+    }
+    return render_image(ctx, options, state);
+  }
+
+  /**
+   * @brief Escribe la imagen PPM y el mapa de coste (--heatmap) y borra el checkpoint
+   */
+  bool write_output(RenderOptions const & options, ConfigParams const & config,
+                    RenderState const & state) {
+    aos::AOSImage image(config.image_width, config.get_image_height());
+    finalise_image(config, state.buffer, image);
+
+    std::ofstream out_file(options.output_file);
+    if (!out_file.is_open()) {
+      std::cerr << "Error: No se pudo abrir el archivo de salida " << options.output_file
+                << '\n';
+      return false;
+    }
+    image.write_ppm(out_file);
+    out_file.close();
+
+    // El render ha terminado: el checkpoint ya no es necesario
+    std::error_code ec;
+    std::filesystem::remove(options.checkpoint_path(), ec);
+
+    std::cerr << "¡Renderizado AOS completado!\nImagen guardada en: " << options.output_file
+              << "\nMuestras trazadas: " << state.buffer.total_samples() << " (media "
+              << static_cast<double>(state.buffer.total_samples()) /
+                     static_cast<double>(state.buffer.total_pixels())
+              << " por píxel)\n";
+
+    // --- Mapa de coste por píxel, en el mismo orden de filas que la imagen ---
+    if (state.cost_map) {
+      if (!state.cost_map->write_ppm(options.heatmap_file, true)) {
+        return false;
+      }
+      std::cerr << "Mapa de coste guardado en: " << options.heatmap_file << " (máximo "
+                << state.cost_map->max_cost() << (options.heatmap_time ? " ns" : " pruebas")
+                << " por píxel)\n";
+    }
+    return true;
+  }
+
+}  // namespace
+
+namespace aos {
+
+  bool AOSRenderer::render(render::RenderJob const & job, std::uint64_t & primary_rays) {
+    // ::ConfigParams es la configuración común; aos::ConfigParams, la de la cámara
+    RenderOptions const & options = job.options;
+    ::ConfigParams const & config = job.config;
+    render::hittable_list world;
+    build_world(job.scene, world);
+
+    // --- Configuramos la Cámara AOS y Generadores Aleatorios ---
+    // (en AOS los rayos de cámara se generan al vuelo dentro de cada fila)
+    aos::Camera const cam = [&config] {
+      render::ScopedTimer const timer("camera_setup", "camera");
+      return aos::Camera(camera_config(config));
+    }();
+
+    int const image_width  = config.image_width;
+    int const image_height = config.get_image_height();
+    RenderState state{
+      .buffer       = render::AccumulationBuffer(image_width, image_height),
+      .ray_rng      = render::RNG(static_cast<std::uint64_t>(config.ray_rng_seed),
+                                  config.rng_engine),
+      .material_rng = render::RNG(static_cast<std::uint64_t>(config.material_rng_seed),
+                                  config.rng_engine),
+    };
+    if (!resume_state(options, config, state)) {
+      return false;
+    }
+    if (!options.heatmap_file.empty()) {
+      state.cost_map.emplace(image_width, image_height,
+                             options.heatmap_time ? render::CostMap::Metric::TIME
+                                                  : render::CostMap::Metric::TESTS);
+    }
+    print_header(options, config);
+
+    render::Sampler const sampler(config.sampler, static_cast<std::uint64_t>(config.ray_rng_seed));
+    RenderContext const ctx{
+      .config = &config, .world = &world, .camera = &cam, .sampler = &sampler};
+    render::ProgressReporter progress(progress_total(options, config, state), "filas",
+                                      options.quiet);
+    state.progress = &progress;
+    if (!run_mode(ctx, options, job.start_time, state)) {
+      return false;
+    }
+    progress.finish();
+    primary_rays = state.buffer.total_samples();
+    return write_output(options, config, state);
+  }
+
+}  // namespace aos
@@ -0,0 +1,486 @@
+#include <benchmark/benchmark.h>
+
+#include "block_rng.hpp"
+#include "geometry_logic.hpp"
+#include "hit_record.hpp"
+#include "hittable.hpp"
+#include "material_logic.hpp"
+#include "materials.hpp"
+#include "math_utilities.hpp"
+#include "objects.hpp"
+#include "ray.hpp"
+#include "ray_packet.hpp"
+#include "sampler.hpp"
+#include "scatter_batch.hpp"
+#include "soa_ray.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+// Cada benchmark recorre un lote fijo de rayos (o de vectores) por iteración, de forma que
+// items_per_second es directamente rayos/s. Los casos de intersección se ejecutan con dos
+// distribuciones (argumento 0 = fallos, 1 = aciertos) y publican la tasa de aciertos real en el
+// contador hit_rate; los de dispersión usan impactos frontales (1) o rasantes (0)
+
+namespace {
+
+  constexpr std::size_t BATCH_SIZE   = 1'024;
+  constexpr std::uint64_t BENCH_SEED = 42;
+  constexpr double T_MIN             = 0.001;
+  constexpr double T_MAX             = std::numeric_limits<double>::infinity();
+
+  // los rayos salen de cerca de (0, 0, -5) hacia un punto del plano z = 0: dentro de un disco de
+  // radio 0.9 (aciertan la esfera/cilindro de radio 1 centrados en el origen) o en una corona de
+  // radios 1.5-3 (fallan)
+  constexpr double CAMERA_Z      = -5.0;
+  constexpr double HIT_RADIUS    = 0.9;
+  constexpr double MISS_INNER    = 1.5;
+  constexpr double MISS_OUTER    = 3.0;
+  constexpr double ORIGIN_JITTER = 0.05;
+
+  bool hit_distribution(benchmark::State & state) {
+    bool const hits = state.range(0) != 0;
+    state.SetLabel(hits ? "hit" : "miss");
+    return hits;
+  }
+
+  std::vector<render::ray> make_rays(bool hits) {
+    render::RNG rng(BENCH_SEED);
+    std::vector<render::ray> rays;
+    rays.reserve(BATCH_SIZE);
+    for (std::size_t i = 0; i < BATCH_SIZE; ++i) {
+      double const angle    = rng.random_double(0.0, 2.0 * std::numbers::pi);
+      double const radius   = hits ? HIT_RADIUS * std::sqrt(rng.random_double())
+                                 : rng.random_double(MISS_INNER, MISS_OUTER);
+      double const origin_x = rng.random_double(-ORIGIN_JITTER, ORIGIN_JITTER);
+      double const origin_y = rng.random_double(-ORIGIN_JITTER, ORIGIN_JITTER);
+      render::point_vector const origin(origin_x, origin_y, CAMERA_Z);
+      render::point_vector const target(radius * std::cos(angle), radius * std::sin(angle), 0.0);
+      rays.emplace_back(origin, render::unit_vector(target - origin));
+    }
+    return rays;
+  }
+
+  void report(benchmark::State & state, std::size_t hits) {
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(BATCH_SIZE));
+    state.counters["hit_rate"] = static_cast<double>(hits) / static_cast<double>(BATCH_SIZE);
+  }
+
+  Sphere unit_sphere() {
+    Sphere sph;
+    sph.radius = 1.0;
+    return sph;
+  }
+
+  Cylinder unit_cylinder() {
+    Cylinder cyl;
+    cyl.radius = 1.0;
+    cyl.axis_y = 1.0;
+    return cyl;
+  }
+
+  // impactos sobre la esfera unidad con un coseno de incidencia en [cos_min, cos_max]
+  struct ScatterInput {
+    render::ray incoming;
+    render::hit_record rec;
+  };
+
+  std::vector<ScatterInput> make_scatter_inputs(bool frontal) {
+    render::RNG rng(BENCH_SEED);
+    double const cos_min = frontal ? 0.9 : 0.0;
+    double const cos_max = frontal ? 1.0 : 0.2;
+    std::vector<ScatterInput> inputs(BATCH_SIZE);
+    for (auto & input : inputs) {
+      render::normal_vector const normal = render::unit_vector(render::random_vec(rng));
+      // dirección entrante: mezcla de -normal y una tangente para fijar el ángulo de incidencia
+      render::direction_vector const tangent =
+          render::unit_vector(render::cross(normal, render::random_vec(rng)));
+      double const cos_theta             = rng.random_double(cos_min, cos_max);
+      double const sin_theta             = std::sqrt(1.0 - cos_theta * cos_theta);
+      render::direction_vector const dir = -cos_theta * normal + sin_theta * tangent;
+      input.incoming                     = render::ray(normal - dir, dir);
+      input.rec.t                        = 1.0;
+      input.rec.intersect                = normal;
+      input.rec.set_face_normal(input.incoming, normal);
+    }
+    return inputs;
+  }
+
+  // --- Intersecciones de common (AOS) ---
+
+  void BM_render_hit_sphere(benchmark::State & state) {
+    auto const rays  = make_rays(hit_distribution(state));
+    Sphere const sph = unit_sphere();
+    std::size_t hits = 0;
+    for (auto _ : state) {
+      hits = 0;
+      for (auto const & r : rays) {
+        double const t = render::hit_sphere(r, T_MIN, T_MAX, &sph);
+        benchmark::DoNotOptimize(t);
+        hits += t > 0 ? 1U : 0U;
+      }
+    }
+    report(state, hits);
+  }
+
+  void BM_render_hit_cylinder(benchmark::State & state) {
+    auto const rays    = make_rays(hit_distribution(state));
+    Cylinder const cyl = unit_cylinder();
+    std::size_t hits   = 0;
+    for (auto _ : state) {
+      hits = 0;
+      for (auto const & r : rays) {
+        double const t = render::hit_cylinder(r, T_MIN, T_MAX, &cyl);
+        benchmark::DoNotOptimize(t);
+        hits += t > 0 ? 1U : 0U;
+      }
+    }
+    report(state, hits);
+  }
+
+  // escena de la esfera unidad rodeada por NEIGHBOURS esferas en el plano z = 0: argumento 0 =
+  // búsqueda en double de hittable_list::hit (sin RENDER_FLOAT), 1 = búsqueda en float con el
+  // impacto más cercano recalculado en double (hit_refined)
+  void BM_world_hit(benchmark::State & state) {
+    constexpr std::size_t NEIGHBOURS = 8;
+    bool const refined               = state.range(0) != 0;
+    state.SetLabel(refined ? "float+refine" : "double");
+    auto const rays = make_rays(true);
+    std::vector<Sphere> spheres(NEIGHBOURS + 1, unit_sphere());
+    render::hittable_list world;
+    for (std::size_t i = 0; i < spheres.size(); ++i) {
+      double const angle  = 2.0 * std::numbers::pi * static_cast<double>(i) /
+                           static_cast<double>(NEIGHBOURS);
+      spheres[i].center_x = i == 0 ? 0.0 : MISS_OUTER * std::cos(angle);
+      spheres[i].center_y = i == 0 ? 0.0 : MISS_OUTER * std::sin(angle);
+      world.add(&spheres[i]);
+    }
+    std::size_t hits = 0;
+    for (auto _ : state) {
+      hits = 0;
+      for (auto const & r : rays) {
+        render::hit_record rec;
+        bool const hit = refined ? world.hit_refined(r, T_MIN, T_MAX, rec)
+                                 : world.hit(r, T_MIN, T_MAX, rec);
+        benchmark::DoNotOptimize(rec);
+        hits += hit ? 1U : 0U;
+      }
+    }
+    report(state, hits);
+  }
+
+  // --- Intersecciones de SOA ---
+
+  void BM_soa_hit_sphere(benchmark::State & state) {
+    auto const rays = make_rays(hit_distribution(state));
+    render::vector const center(0.0, 0.0, 0.0);
+    ray::IntersectionParams const params{.t_min = T_MIN, .t_max = T_MAX};
+    std::size_t hits = 0;
+    for (auto _ : state) {
+      hits = 0;
+      for (auto const & r : rays) {
+        auto const rec = ray::hit_sphere(r, center, 1.0, params);
+        benchmark::DoNotOptimize(rec);
+        hits += rec ? 1U : 0U;
+      }
+    }
+    report(state, hits);
+  }
+
+  void BM_soa_hit_cylinder(benchmark::State & state) {
+    auto const rays = make_rays(hit_distribution(state));
+    ray::CylinderParams const cyl{
+      .center = {0.0, 0.0, 0.0},
+      .radius = 1.0,
+      .axis   = {0.0, 1.0, 0.0},
+      .height = 2.0,
+    };
+    ray::IntersectionParams const params{.t_min = T_MIN, .t_max = T_MAX};
+    std::size_t hits = 0;
+    for (auto _ : state) {
+      hits = 0;
+      for (auto const & r : rays) {
+        auto const rec = ray::hit_cylinder(r, cyl, params);
+        benchmark::DoNotOptimize(rec);
+        hits += rec ? 1U : 0U;
+      }
+    }
+    report(state, hits);
+  }
+
+  // --- Paquetes de rayos primarios de SOA ---
+
+  // rayos de cámara coherentes como los de una ola: rejilla de 32x32 direcciones desde
+  // (0, 0, CAMERA_Z) hacia el cuadrado [-MISS_OUTER, MISS_OUTER]^2 del plano z = 0, por filas
+  soa::PathQueue make_primary_queue() {
+    constexpr std::size_t SIDE = 32;
+    soa::PathQueue q(SIDE * SIDE);
+    double const step = 2.0 * MISS_OUTER / static_cast<double>(SIDE);
+    for (std::size_t k = 0; k < q.capacity(); ++k) {
+      double const x           = -MISS_OUTER + step * static_cast<double>(k % SIDE);
+      double const y           = -MISS_OUTER + step * static_cast<double>(k / SIDE);
+      render::vector const dir = render::unit_vector(render::vector{x, y, -CAMERA_Z});
+      q.origin_z[k]            = static_cast<render::real>(CAMERA_Z);
+      q.dir_x[k]               = static_cast<render::real>(dir.get_x());
+      q.dir_y[k]               = static_cast<render::real>(dir.get_y());
+      q.dir_z[k]               = static_cast<render::real>(dir.get_z());
+    }
+    q.size = q.capacity();
+    return q;
+  }
+
+  // descarte por cono más prueba por carriles contra la esfera unidad; N = 1 es el rayo a rayo
+  template <std::size_t N>
+  void BM_soa_sphere_packet(benchmark::State & state) {
+    soa::PathQueue q                = make_primary_queue();
+    Sphere const sph                = unit_sphere();
+    soa::BoundingSphere const bound = soa::bounding_sphere(sph);
+    for (auto _ : state) {
+      std::ranges::fill(q.hit_t, T_MAX);
+      for (std::size_t begin = 0; begin < q.size; begin += N) {
+        auto const cone = soa::packet_cone<N>(q, begin);
+        if (cone and !soa::cone_misses(*cone, bound, T_MAX)) {
+          soa::intersect_sphere_packet<N>(q, begin, sph);
+        }
+      }
+      benchmark::DoNotOptimize(q.hit_t.data());
+    }
+    report(state, static_cast<std::size_t>(std::ranges::count_if(
+                      q.hit_t, [](double t) { return t < T_MAX; })));
+  }
+
+  // --- Dispersión por material ---
+
+  bool frontal_distribution(benchmark::State & state) {
+    bool const frontal = state.range(0) != 0;
+    state.SetLabel(frontal ? "frontal" : "grazing");
+    return frontal;
+  }
+
+  // ejecuta 'scatter_fn(input, io)' sobre el lote; hit_rate cuenta los rayos no absorbidos
+  template <typename ScatterFn>
+  void run_scatter(benchmark::State & state, ScatterFn scatter_fn) {
+    auto const inputs = make_scatter_inputs(frontal_distribution(state));
+    render::RNG rng(BENCH_SEED);
+    render::color_vector attenuation;
+    render::ray scattered;
+    render::ScatterIO io{.attenuation = &attenuation, .scattered = &scattered, .rng = &rng};
+    std::size_t hits = 0;
+    for (auto _ : state) {
+      hits = 0;
+      for (auto const & input : inputs) {
+        bool const bounced = scatter_fn(input, io);
+        benchmark::DoNotOptimize(scattered);
+        hits += bounced ? 1U : 0U;
+      }
+    }
+    report(state, hits);
+  }
+
+  void BM_scatter_matte(benchmark::State & state) {
+    MatteMaterial mat;
+    mat.reflectance_r = mat.reflectance_g = mat.reflectance_b = 0.5;
+    run_scatter(state, [&mat](ScatterInput const & input, render::ScatterIO & io) {
+      return render::scatter_matte(input.rec, &mat, io);
+    });
+  }
+
+  // misma entrada con el muestreo coseno del hemisferio (mattescatter: cosine)
+  void BM_scatter_matte_cosine(benchmark::State & state) {
+    MatteMaterial mat;
+    mat.reflectance_r = mat.reflectance_g = mat.reflectance_b = 0.5;
+    run_scatter(state, [&mat](ScatterInput const & input, render::ScatterIO & io) {
+      io.matte_scatter = MatteScatter::COSINE;
+      return render::scatter_matte(input.rec, &mat, io);
+    });
+  }
+
+  void BM_scatter_metal(benchmark::State & state) {
+    MetalMaterial mat;
+    mat.reflectance_r = mat.reflectance_g = mat.reflectance_b = 0.8;
+    mat.diffusion     = 0.3;
+    run_scatter(state, [&mat](ScatterInput const & input, render::ScatterIO & io) {
+      return render::scatter_metal(input.incoming, input.rec, &mat, io);
+    });
+  }
+
+  void BM_scatter_refractive(benchmark::State & state) {
+    RefractiveMaterial mat;
+    mat.refractive_index = 1.5;
+    run_scatter(state, [&mat](ScatterInput const & input, render::ScatterIO & io) {
+      return render::scatter_refractive(input.incoming, input.rec, &mat, io);
+    });
+  }
+
+  // --- Dispersión por lotes (scatter_batch.hpp) ---
+
+  // las entradas de run_scatter en columnas
+  render::ScatterBatch make_scatter_batch(bool frontal) {
+    auto const inputs = make_scatter_inputs(frontal);
+    render::ScatterBatch batch(inputs.size());
+    batch.size = inputs.size();
+    for (std::size_t k = 0; k < inputs.size(); ++k) {
+      batch.dir_x[k]      = inputs[k].incoming.dir.get_x();
+      batch.dir_y[k]      = inputs[k].incoming.dir.get_y();
+      batch.dir_z[k]      = inputs[k].incoming.dir.get_z();
+      batch.normal_x[k]   = inputs[k].rec.normal.get_x();
+      batch.normal_y[k]   = inputs[k].rec.normal.get_y();
+      batch.normal_z[k]   = inputs[k].rec.normal.get_z();
+      batch.front_face[k] = inputs[k].rec.front_face ? 1 : 0;
+    }
+    return batch;
+  }
+
+  // cada iteración saca del RNG los 'uniforms' números por impacto (como la etapa shade del
+  // trazador SOA) y ejecuta 'kernel(batch)' sobre el lote entero
+  template <typename Kernel>
+  void run_scatter_batch(benchmark::State & state, std::size_t uniforms, Kernel kernel) {
+    render::ScatterBatch batch = make_scatter_batch(frontal_distribution(state));
+    render::RNG rng(BENCH_SEED);
+    std::size_t hits = 0;
+    for (auto _ : state) {
+      for (std::size_t u = 0; u < uniforms; ++u) {
+        std::ranges::generate(batch.uniforms[u], [&rng] { return rng.random_double(); });
+      }
+      benchmark::DoNotOptimize(kernel(batch));
+      benchmark::DoNotOptimize(batch.out_x.data());
+      hits = static_cast<std::size_t>(std::ranges::count(batch.bounced, std::uint8_t{1}));
+    }
+    report(state, hits);
+  }
+
+  void BM_scatter_matte_batch(benchmark::State & state) {
+    MatteMaterial mat;
+    mat.reflectance_r = mat.reflectance_g = mat.reflectance_b = 0.5;
+    run_scatter_batch(state, 3, [&mat](render::ScatterBatch & batch) {
+      return render::scatter_matte_batch(mat, MatteScatter::CUBE, batch);
+    });
+  }
+
+  void BM_scatter_metal_batch(benchmark::State & state) {
+    MetalMaterial mat;
+    mat.reflectance_r = mat.reflectance_g = mat.reflectance_b = 0.8;
+    mat.diffusion     = 0.3;
+    run_scatter_batch(state, 3, [&mat](render::ScatterBatch & batch) {
+      return render::scatter_metal_batch(mat, batch);
+    });
+  }
+
+  void BM_scatter_refractive_batch(benchmark::State & state) {
+    RefractiveMaterial mat;
+    mat.refractive_index = 1.5;
+    run_scatter_batch(state, 0, [&mat](render::ScatterBatch & batch) {
+      return render::scatter_refractive_batch(mat, batch);
+    });
+  }
+
+  // --- Generador aleatorio ---
+
+  // argumento 0 = Mersenne-Twister, 1 = xoshiro256+ por bloques (clave 'rng')
+  void BM_rng_random_double(benchmark::State & state) {
+    bool const xoshiro = state.range(0) != 0;
+    state.SetLabel(xoshiro ? "xoshiro" : "mt19937");
+    render::RNG rng(BENCH_SEED, xoshiro ? RngEngine::XOSHIRO : RngEngine::MT19937);
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < BATCH_SIZE; ++i) {
+        benchmark::DoNotOptimize(rng.random_double());
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(BATCH_SIZE));
+  }
+
+  // relleno directo de un bloque de double o float
+  template <typename T>
+  void BM_block_rng_fill(benchmark::State & state) {
+    render::BlockRNG rng(BENCH_SEED);
+    std::vector<T> values(BATCH_SIZE);
+    for (auto _ : state) {
+      rng.fill(values);
+      benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(BATCH_SIZE));
+  }
+
+  // --- Secuencias de baja discrepancia ---
+
+  // números de SAMPLER_DIMENSIONS dimensiones consecutivas (offset en el píxel y tres rebotes)
+  // de una muestra por píxel de un tile de 32x32, como los pide el render con SampleStream
+  constexpr std::uint32_t SAMPLER_DIMENSIONS = 8;
+
+  // argumento: SamplerType (1 = halton, 2 = sobol, 3 = bluenoise)
+  void BM_sampler_stream(benchmark::State & state) {
+    auto const type = static_cast<SamplerType>(state.range(0));
+    state.SetLabel(render::sampler_name(type));
+    render::Sampler const sampler(type, BENCH_SEED);
+    std::uint32_t index = 0;
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < BATCH_SIZE; ++i) {
+        render::SamplePoint const point{.x = static_cast<int>(i % 32),
+                                        .y = static_cast<int>(i / 32), .index = index};
+        render::SampleStream stream(sampler, point);
+        for (std::uint32_t d = 0; d < SAMPLER_DIMENSIONS; ++d) {
+          benchmark::DoNotOptimize(stream.next());
+        }
+      }
+      ++index;
+    }
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(BATCH_SIZE * SAMPLER_DIMENSIONS));
+  }
+
+  // --- Operadores de vector (render::basic_vector con y sin relleno, en double y float) ---
+
+  // combina las operaciones del camino caliente: suma, escala, dot, cross y normalización
+  template <typename Vec>
+  void BM_vector_ops(benchmark::State & state) {
+    using T = Vec::value_type;
+    render::RNG rng(BENCH_SEED);
+    auto const random = [&rng] { return static_cast<T>(rng.random_double()); };
+    std::vector<Vec> a;
+    std::vector<Vec> b;
+    for (std::size_t i = 0; i < BATCH_SIZE; ++i) {
+      a.emplace_back(random(), random(), random());
+      b.emplace_back(random(), random(), random());
+    }
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < BATCH_SIZE; ++i) {
+        Vec const n = unit_vector(cross(a[i], b[i]));
+        Vec const r = a[i] - T{2} * dot(a[i], n) * n + b[i] / T{3};
+        benchmark::DoNotOptimize(r);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(BATCH_SIZE));
+  }
+
+}  // namespace
+
+BENCHMARK(BM_render_hit_sphere)->Arg(0)->Arg(1);
+BENCHMARK(BM_render_hit_cylinder)->Arg(0)->Arg(1);
+BENCHMARK(BM_world_hit)->Arg(0)->Arg(1);
+BENCHMARK(BM_soa_hit_sphere)->Arg(0)->Arg(1);
+BENCHMARK(BM_soa_hit_cylinder)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_soa_sphere_packet, 1);
+BENCHMARK_TEMPLATE(BM_soa_sphere_packet, 4);
+BENCHMARK_TEMPLATE(BM_soa_sphere_packet, 8);
+BENCHMARK_TEMPLATE(BM_soa_sphere_packet, 16);
+BENCHMARK(BM_scatter_matte)->Arg(0)->Arg(1);
+BENCHMARK(BM_scatter_matte_cosine)->Arg(0)->Arg(1);
+BENCHMARK(BM_scatter_metal)->Arg(0)->Arg(1);
+BENCHMARK(BM_scatter_refractive)->Arg(0)->Arg(1);
+BENCHMARK(BM_scatter_matte_batch)->Arg(0)->Arg(1);
+BENCHMARK(BM_scatter_metal_batch)->Arg(0)->Arg(1);
+BENCHMARK(BM_scatter_refractive_batch)->Arg(0)->Arg(1);
+BENCHMARK(BM_rng_random_double)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_block_rng_fill, double);
+BENCHMARK_TEMPLATE(BM_block_rng_fill, float);
+BENCHMARK(BM_sampler_stream)->Arg(1)->Arg(2)->Arg(3);
+BENCHMARK_TEMPLATE(BM_vector_ops, render::basic_vector<double, 3>);
+BENCHMARK_TEMPLATE(BM_vector_ops, render::basic_vector<double, 4>);
+BENCHMARK_TEMPLATE(BM_vector_ops, render::basic_vector<float, 3>);
+BENCHMARK_TEMPLATE(BM_vector_ops, render::basic_vector<float, 4>);
@@ -0,0 +1,387 @@
+// Driver de benchmark extremo a extremo: compara render-aos y render-soa sobre escenas generadas
+// con número de objetos y resolución crecientes, y escribe los resultados en JSON
+// Uso: bench-render [--aos <exe>] [--soa <exe>] [--output <json>] [--work-dir <dir>]
+//                   [--objects 4,16,64] [--widths 160,320] [--processes 1,2,4]
+//                   [--repeats 3] [--samples 4] [--max-depth 5]
+
+#include "config.hpp"
+#include "config_parser.hpp"
+#include "math_utilities.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+extern char ** environ;
+
+namespace {
+
+  struct BenchOptions {
+    std::string aos_path = RENDER_AOS_PATH;  // rutas por defecto fijadas por CMake
+    std::string soa_path = RENDER_SOA_PATH;
+    std::string output   = "bench-render.json";
+    std::string work_dir = (std::filesystem::temp_directory_path() / "bench-render").string();
+    std::vector<int> objects{4, 16, 64};
+    std::vector<int> widths{160, 320};
+    // procesos simultáneos: los renderizadores son de un hilo, así que la escalabilidad se mide
+    // lanzando N renders a la vez (compiten por caché y ancho de banda de memoria)
+    std::vector<int> processes{1, 2, 4};
+    int repeats   = 3;
+    int samples   = 4;
+    int max_depth = 5;
+  };
+
+  // --- Opciones de línea de comandos (mismo esquema que cli_options.cpp) ---
+
+  using OptionHandler =
+      std::function<bool(BenchOptions &, std::vector<std::string> const &, std::size_t &)>;
+
+  bool next_value(std::vector<std::string> const & args, std::size_t & idx, std::string & value) {
+    if (idx + 1 >= args.size()) {
+      std::cerr << "Missing value for option " << args[idx] << '\n';
+      return false;
+    }
+    value = args[++idx];
+    return true;
+  }
+
+  // lista de enteros positivos separados por comas ("4,16,64")
+  bool next_int_list(std::vector<std::string> const & args, std::size_t & idx,
+                     std::vector<int> & values) {
+    std::string text;
+    if (!next_value(args, idx, text)) {
+      return false;
+    }
+    values.clear();
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+      try {
+        std::size_t used = 0;
+        int const value  = std::stoi(item, &used);
+        if (used == item.size() and value > 0) {
+          values.push_back(value);
+          continue;
+        }
+      } catch (...) {
+        // se informa abajo
+      }
+      break;
+    }
+    if (values.empty() or !in.eof()) {
+      std::cerr << "Invalid value for option " << args[idx - 1] << ": " << text << '\n';
+      return false;
+    }
+    return true;
+  }
+
+  bool next_int(std::vector<std::string> const & args, std::size_t & idx, int & value) {
+    std::vector<int> values;
+    if (!next_int_list(args, idx, values)) {
+      return false;
+    }
+    if (values.size() != 1) {
+      std::cerr << "Option " << args[idx - 1] << " expects a single value\n";
+      return false;
+    }
+    value = values.front();
+    return true;
+  }
+
+  // asocia cada opción a la función que lee su valor en el campo correspondiente
+  template <auto Reader, auto Field>
+  bool read_into(BenchOptions & options, std::vector<std::string> const & args,
+                 std::size_t & idx) {
+    return Reader(args, idx, options.*Field);
+  }
+
+  std::unordered_map<std::string, OptionHandler> const & get_option_handlers() {
+    using O = BenchOptions;
+    static std::unordered_map<std::string, OptionHandler> const handlers = {
+      {      "--aos",    read_into<next_value, &O::aos_path>},
+      {      "--soa",    read_into<next_value, &O::soa_path>},
+      {   "--output",      read_into<next_value, &O::output>},
+      { "--work-dir",    read_into<next_value, &O::work_dir>},
+      {  "--objects", read_into<next_int_list, &O::objects>},
+      {   "--widths",  read_into<next_int_list, &O::widths>},
+      {"--processes", read_into<next_int_list, &O::processes>},
+      {  "--repeats",        read_into<next_int, &O::repeats>},
+      {  "--samples",        read_into<next_int, &O::samples>},
+      {"--max-depth",      read_into<next_int, &O::max_depth>},
+    };
+    return handlers;
+  }
+
+  bool parse_bench_options(std::vector<std::string> const & args, BenchOptions & options) {
+    auto const & handlers = get_option_handlers();
+    for (std::size_t idx = 1; idx < args.size(); ++idx) {
+      auto it = handlers.find(args[idx]);
+      if (it == handlers.end()) {
+        std::cerr << "Unknown option: " << args[idx] << '\n';
+        return false;
+      }
+      if (!it->second(options, args, idx)) {
+        return false;
+      }
+    }
+    std::ranges::sort(options.processes);
+    return true;
+  }
+
+  // --- Generación de escenas ---
+
+  // configuración común a los dos renderizadores (mismo formato de texto que lee el parser)
+  bool write_config_file(std::string const & path, int width, BenchOptions const & options) {
+    ConfigParams config;
+    config.image_width       = width;
+    config.samples_per_pixel = options.samples;
+    config.max_depth         = options.max_depth;
+    config.field_of_view     = 60.0;
+    std::ofstream out(path);
+    if (!out.is_open()) {
+      std::cerr << "Error: Cannot create config file " << path << '\n';
+      return false;
+    }
+    write_config(out, config);
+    return static_cast<bool>(out);
+  }
+
+  // 'objects' esferas y cilindros (uno de cada cuatro) repartidos al azar delante de la cámara,
+  // con los tres tipos de material; la semilla es fija para que la escena sea reproducible
+  bool write_scene_file(std::string const & path, int objects) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+      std::cerr << "Error: Cannot create scene file " << path << '\n';
+      return false;
+    }
+    out << "matte: mate 0.7 0.6 0.5\nmetal: metal 0.8 0.8 0.9 0.2\nrefractive: vidrio 1.5\n";
+    std::array<char const *, 3> const materials{"mate", "metal", "vidrio"};
+    render::RNG rng(static_cast<std::uint64_t>(objects));
+    for (int k = 0; k < objects; ++k) {
+      double const x       = rng.random_double(-4.0, 4.0);
+      double const y       = rng.random_double(-2.5, 2.5);
+      double const z       = rng.random_double(-2.0, 2.0);
+      double const radius  = rng.random_double(0.2, 0.6);
+      char const * const m = materials.at(static_cast<std::size_t>(k) % materials.size());
+      if (k % 4 == 3) {
+        out << "cylinder: " << x << ' ' << y << ' ' << z << ' ' << radius << " 0 1 0 " << m << '\n';
+      } else {
+        out << "sphere: " << x << ' ' << y << ' ' << z << ' ' << radius << ' ' << m << '\n';
+      }
+    }
+    return static_cast<bool>(out);
+  }
+
+  // --- Ejecución y medida ---
+
+  // caso de benchmark: un renderizador sobre una escena y configuración ya escritas
+  struct BenchCase {
+    std::string backend;
+    std::string executable;
+    std::string config_file;
+    std::string scene_file;
+  };
+
+  // resultado de una combinación (renderizador, escena, resolución, procesos simultáneos)
+  struct Measurement {
+    std::string backend;
+    int objects   = 0;
+    int width     = 0;
+    int height    = 0;
+    int processes = 0;
+    // segundos hasta que termina el último proceso, uno por repetición
+    std::vector<double> wall_times;
+    // máximo de ru_maxrss entre todos los procesos
+    long peak_rss_kb = 0;
+  };
+
+  // lanza el comando 'processes' veces a la vez (salida a /dev/null) y espera a que terminen
+  bool run_concurrently(BenchCase const & bench, Measurement & result,
+                        std::string const & work_dir) {
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, 1, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&actions, 2, "/dev/null", O_WRONLY, 0);
+
+    auto const start = std::chrono::steady_clock::now();
+    std::vector<pid_t> pids;
+    for (int p = 0; p < result.processes; ++p) {
+      std::string image = work_dir + "/" + bench.backend + "-" + std::to_string(p) + ".ppm";
+      // --quiet: sin el hilo del indicador de progreso dentro de la medida
+      std::array<std::string, 5> args{bench.executable, bench.config_file, bench.scene_file, image,
+                                      "--quiet"};
+      std::array<char *, 6> argv{args[0].data(), args[1].data(), args[2].data(),
+                                 args[3].data(), args[4].data(), nullptr};
+      pid_t pid = 0;
+      if (posix_spawn(&pid, argv[0], &actions, nullptr, argv.data(), environ) == 0) {
+        pids.push_back(pid);
+      }
+    }
+    posix_spawn_file_actions_destroy(&actions);
+
+    bool ok = std::ssize(pids) == result.processes;
+    for (pid_t const pid : pids) {
+      int status = 0;
+      rusage usage{};
+      bool const exited  = wait4(pid, &status, 0, &usage) == pid and WIFEXITED(status);
+      ok                 = ok and exited and WEXITSTATUS(status) == 0;
+      result.peak_rss_kb = std::max(result.peak_rss_kb, usage.ru_maxrss);
+    }
+    std::chrono::duration<double> const wall = std::chrono::steady_clock::now() - start;
+    result.wall_times.push_back(wall.count());
+    return ok;
+  }
+
+  bool measure(BenchCase const & bench, BenchOptions const & options, Measurement & result) {
+    for (int r = 0; r < options.repeats; ++r) {
+      if (!run_concurrently(bench, result, options.work_dir)) {
+        std::cerr << "Error: " << bench.executable << " failed on " << bench.scene_file << '\n';
+        return false;
+      }
+    }
+    return true;
+  }
+
+  double median(std::vector<double> values) {
+    std::ranges::sort(values);
+    std::size_t const mid = values.size() / 2;
+    return values.size() % 2 == 1 ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+  }
+
+  // --- Salida JSON ---
+
+  // rayos primarios por segundo (w * h * spp por proceso, sumados entre procesos) y eficiencia
+  // de escalado: rendimiento por proceso respecto al de la medida base (menos procesos), es decir
+  // t_base / t_N
+  void write_measurement(std::ostream & out, Measurement const & m, double base_wall,
+                         int samples) {
+    double const wall = median(m.wall_times);
+    double const rays = static_cast<double>(m.width) * m.height * samples * m.processes;
+    out << "    {\"backend\": \"" << m.backend << "\", \"objects\": " << m.objects
+        << ", \"width\": " << m.width << ", \"height\": " << m.height
+        << ", \"processes\": " << m.processes << ",\n     \"wall_time_s\": {\"median\": " << wall
+        << ", \"min\": " << std::ranges::min(m.wall_times)
+        << ", \"max\": " << std::ranges::max(m.wall_times) << ", \"runs\": [";
+    for (std::size_t i = 0; i < m.wall_times.size(); ++i) {
+      out << (i == 0 ? "" : ", ") << m.wall_times[i];
+    }
+    out << "]},\n     \"primary_rays_per_second\": " << rays / wall
+        << ", \"peak_rss_kb\": " << m.peak_rss_kb
+        << ", \"scaling_efficiency\": " << base_wall / wall << "}";
+  }
+
+  bool write_json(std::string const & path, BenchOptions const & options,
+                  std::vector<Measurement> const & results) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+      std::cerr << "Error: Cannot create output file " << path << '\n';
+      return false;
+    }
+    out << "{\n  \"samples_per_pixel\": " << options.samples << ",\n  \"max_depth\": "
+        << options.max_depth << ",\n  \"repeats\": " << options.repeats
+        << ",\n  \"hardware_threads\": " << std::thread::hardware_concurrency()
+        << ",\n  \"results\": [\n";
+    // las medidas de un mismo caso van seguidas, empezando por la de menos procesos
+    double base_wall = 0.0;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      if (results[i].processes == options.processes.front()) {
+        base_wall = median(results[i].wall_times);
+      }
+      write_measurement(out, results[i], base_wall, options.samples);
+      out << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+  }
+
+  // --- Bucle de casos ---
+
+  // mide los dos renderizadores con todas las cantidades de procesos sobre una escena y config
+  bool run_backends(BenchCase bench, Measurement const & base, BenchOptions const & options,
+                    std::vector<Measurement> & results) {
+    for (auto const & [backend, executable] :
+         {std::pair{"aos", options.aos_path}, std::pair{"soa", options.soa_path}})
+    {
+      bench.backend    = backend;
+      bench.executable = executable;
+      for (int const processes : options.processes) {
+        Measurement m = base;
+        m.backend     = backend;
+        m.processes   = processes;
+        std::cerr << backend << ": objetos=" << m.objects << " ancho=" << m.width
+                  << " procesos=" << processes << '\n';
+        if (!measure(bench, options, m)) {
+          return false;
+        }
+        results.push_back(std::move(m));
+      }
+    }
+    return true;
+  }
+
+  bool run_all(BenchOptions const & options, std::vector<Measurement> & results) {
+    std::filesystem::path const dir(options.work_dir);
+    for (int const objects : options.objects) {
+      std::string const scene = (dir / ("scene-" + std::to_string(objects) + ".txt")).string();
+      if (!write_scene_file(scene, objects)) {
+        return false;
+      }
+      for (int const width : options.widths) {
+        std::string const config = (dir / ("config-" + std::to_string(width) + ".cfg")).string();
+        if (!write_config_file(config, width, options)) {
+          return false;
+        }
+        ConfigParams sizes;
+        sizes.image_width = width;
+        Measurement base;
+        base.objects = objects;
+        base.width   = width;
+        base.height  = sizes.get_image_height();
+        BenchCase bench;
+        bench.config_file = config;
+        bench.scene_file  = scene;
+        if (!run_backends(bench, base, options, results)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+}  // namespace
+
+int main(int argc, char * argv[]) {
+  std::vector<std::string> const args(argv, argv + argc);
+  BenchOptions options;
+  if (!parse_bench_options(args, options)) {
+    return 1;
+  }
+  std::error_code ec;
+  std::filesystem::create_directories(options.work_dir, ec);
+  if (ec) {
+    std::cerr << "Error: Cannot create work directory " << options.work_dir << '\n';
+    return 1;
+  }
+
+  std::vector<Measurement> results;
+  if (!run_all(options, results) or !write_json(options.output, options, results)) {
+    return 1;
+  }
+  std::cerr << "Resultados guardados en: " << options.output << '\n';
+  return 0;
+}
@@ -0,0 +1,67 @@
+#ifndef RENDER_ACCUMULATION_BUFFER_HPP
+#define RENDER_ACCUMULATION_BUFFER_HPP
+
+#include "vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <vector>
+
+namespace render {
+
+  // CLASE QUE ACUMULA LAS MUESTRAS DE COLOR DE CADA PÍXEL
+  // guarda la suma lineal de cada canal (un array por canal) y el número de muestras tomadas, de
+  // forma que el render se puede interrumpir, serializar y reanudar sin perder trabajo
+  class AccumulationBuffer {
+  public:
+    AccumulationBuffer(int width, int height);
+
+    // añade una muestra al píxel (x, y)
+    void add_sample(int x, int y, color_vector const & color);
+    // añade de una vez 'count' muestras cuya suma es 'sum'
+    void add_samples(int x, int y, color_vector const & sum, std::uint32_t count);
+
+    // color medio del píxel (negro si todavía no tiene muestras)
+    [[nodiscard]] color_vector average(int x, int y) const;
+
+    // medias de toda la fila y, un array por canal (entrada de GammaLUT::quantize)
+    void row_average(int y, std::span<double> r, std::span<double> g, std::span<double> b) const;
+
+    [[nodiscard]] std::uint32_t sample_count(int x, int y) const { return counts_[index(x, y)]; }
+
+    // número total de muestras acumuladas en toda la imagen
+    [[nodiscard]] std::uint64_t total_samples() const;
+
+    [[nodiscard]] int width() const { return width_; }
+
+    [[nodiscard]] int height() const { return height_; }
+
+    [[nodiscard]] std::size_t total_pixels() const {
+      return static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_);
+    }
+
+    // SERIALIZACIÓN (binaria, en el orden de bytes de la máquina; pensada para ficheros locales)
+    void write(std::ostream & out) const;
+    // falla si las dimensiones guardadas no coinciden con las del buffer
+    bool read(std::istream & in);
+
+  private:
+    int width_;
+    int height_;
+
+    // sumas por canal y número de muestras de cada píxel
+    std::vector<double> sum_r_;
+    std::vector<double> sum_g_;
+    std::vector<double> sum_b_;
+    std::vector<std::uint32_t> counts_;
+
+    [[nodiscard]] std::size_t index(int x, int y) const {
+      return static_cast<std::size_t>(y) * static_cast<std::size_t>(width_) +
+             static_cast<std::size_t>(x);
+    }
+  };
+
+}  // namespace render
+
+#endif  // RENDER_ACCUMULATION_BUFFER_HPP
@@ -0,0 +1,80 @@
+#ifndef RENDER_ALLOC_COUNTER_HPP
+#define RENDER_ALLOC_COUNTER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace render {
+
+  // ASIGNACIONES DE MEMORIA DINÁMICA (--alloc-stats)
+  // Con la opción de CMake ENABLE_ALLOC_COUNTING (RENDER_ALLOC_COUNTING) alloc_counter.cpp
+  // sustituye el operator new/delete global por uno que cuenta, por hilo, cuántas asignaciones y
+  // bytes se piden. Sin ella no hay sustitución y thread_allocations() siempre devuelve cero
+  struct AllocationCount {
+    std::uint64_t allocations{};
+    std::uint64_t bytes{};
+  };
+
+  // asignaciones hechas por el hilo actual desde que arrancó, sin las de los propios perfiles
+  [[nodiscard]] AllocationCount thread_allocations();
+
+  // vuelve el contador del hilo actual a 'mark': lo asignado desde entonces fue el registro de una
+  // fase en los perfiles (ScopedTimer) y no debe contar para las fases que la contienen
+  void rewind_thread_allocations(AllocationCount const & mark);
+
+  // ¿se compiló la sustitución de operator new?
+  constexpr bool allocation_counting_enabled() {
+#ifdef RENDER_ALLOC_COUNTING
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // ASIGNACIONES POR FASE: cada ScopedTimer suma lo que asignó su hilo entre la construcción y la
+  // destrucción. Las fases de categoría "render" (filas y pasadas) forman el bucle de render, que
+  // no debe asignar nada
+  class AllocationProfile {
+  public:
+    static AllocationProfile & instance();
+
+    AllocationProfile(AllocationProfile const &)             = delete;
+    AllocationProfile & operator=(AllocationProfile const &) = delete;
+    AllocationProfile(AllocationProfile &&)                  = delete;
+    AllocationProfile & operator=(AllocationProfile &&)      = delete;
+
+    void enable() { active_.store(true, std::memory_order_relaxed); }
+
+    [[nodiscard]] bool active() const { return active_.load(std::memory_order_relaxed); }
+
+    void add_phase(char const * name, char const * category, AllocationCount const & delta);
+
+    // asignaciones acumuladas en las fases de la categoría dada
+    [[nodiscard]] AllocationCount category_total(std::string_view category) const;
+
+    // tabla por fase: llamadas, asignaciones y bytes
+    void write_report(std::ostream & out) const;
+
+  private:
+    AllocationProfile() = default;
+
+    struct PhaseTotals {
+      std::string name;
+      std::string category;
+      std::uint64_t calls = 0;
+      AllocationCount count;
+    };
+
+    std::atomic<bool> active_{false};
+    mutable std::mutex mutex_;
+    std::vector<PhaseTotals> phases_;  // en orden de primera aparición
+  };
+
+}  // namespace render
+
+#endif  // RENDER_ALLOC_COUNTER_HPP
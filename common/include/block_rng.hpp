@@ -0,0 +1,47 @@
+#ifndef RENDER_BLOCK_RNG_HPP
+#define RENDER_BLOCK_RNG_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+
+namespace render {
+
+  // XOSHIRO256+ EN VARIOS CARRILES
+  // LANES generadores xoshiro256+ avanzan a la vez con el estado en columnas (state_[palabra]
+  // [carril]): cada paso son LANES números con las mismas operaciones de 64 bits en todos los
+  // carriles, que el compilador vectoriza. El carril 0 se siembra con splitmix64 y el carril i
+  // empieza i saltos de 2^128 pasos después, así que sus subsecuencias no se solapan.
+  // Los números se entregan por bloques: los 52 bits altos de cada salida son la mantisa de un
+  // double en [1, 2), al que se resta 1 (23 bits y float en [1, 2) para los float)
+  class BlockRNG {
+  public:
+    static constexpr std::size_t LANES = 4;
+
+    explicit BlockRNG(std::uint64_t seed);
+
+    // avanza cada carril LANES saltos: el generador pasa a las LANES subsecuencias siguientes,
+    // disjuntas de las que tenía (un generador por hilo o por proceso con la misma semilla)
+    void jump();
+
+    // rellena 'out' con uniformes en [0, 1); si su tamaño no es múltiplo de LANES se descartan
+    // los números sobrantes del último paso
+    void fill(std::span<double> out);
+    void fill(std::span<float> out);
+
+    // estado (las 4 * LANES palabras) para checkpoints
+    void save_state(std::ostream & out) const;
+    bool load_state(std::istream & in);
+
+  private:
+    // salida de los LANES carriles y avance de un paso
+    std::array<std::uint64_t, LANES> next();
+
+    std::array<std::array<std::uint64_t, LANES>, 4> state_{};
+  };
+
+}  // namespace render
+
+#endif  // RENDER_BLOCK_RNG_HPP
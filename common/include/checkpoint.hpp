@@ -0,0 +1,33 @@
+#ifndef RENDER_CHECKPOINT_HPP
+#define RENDER_CHECKPOINT_HPP
+
+#include "accumulation_buffer.hpp"
+#include "config.hpp"
+#include "math_utilities.hpp"
+#include <cstdint>
+#include <string>
+
+namespace render {
+
+  // ESTADO DE UN RENDER EN CURSO QUE SE GUARDA EN UN CHECKPOINT
+  // agrupa punteros al estado vivo del render (igual que ScatterIO), de forma que guardar y
+  // restaurar no necesita copias intermedias
+  struct CheckpointData {
+    ConfigParams const * config;
+    AccumulationBuffer * buffer;
+    RNG * ray_rng;
+    RNG * material_rng;
+    // unidades de trabajo terminadas (filas en el render por píxel)
+    std::int64_t progress;
+  };
+
+  // escribe el checkpoint en un fichero temporal y lo renombra, de forma que una interrupción
+  // durante la escritura nunca deja un checkpoint corrupto en lugar del anterior
+  bool save_checkpoint(std::string const & filename, CheckpointData const & data);
+
+  // restaura buffer, RNGs y progreso. Falla si el checkpoint se generó con otra configuración
+  bool load_checkpoint(std::string const & filename, CheckpointData & data);
+
+}  // namespace render
+
+#endif  // RENDER_CHECKPOINT_HPP
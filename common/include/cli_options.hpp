@@ -0,0 +1,79 @@
+#ifndef CLI_OPTIONS_HPP
+#define CLI_OPTIONS_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Backend de render (renderer.hpp): AOS traza rayo a rayo sobre hittable_list y SOA por olas de
+// caminos en columnas
+enum class Backend : std::uint8_t { AOS, SOA };
+
+// Opciones de línea de comandos comunes a los renderizadores
+// Uso: <programa> <config_file> <scene_file> <output_file> [opciones]
+struct RenderOptions {
+  std::string config_file;
+  std::string scene_file;
+  std::string output_file;
+
+  // backend elegido con --backend (sin valor => el del ejecutable: AOS en render-aos, SOA en
+  // render-soa)
+  std::optional<Backend> backend;
+
+  // checkpoints periódicos del render (--checkpoint, --checkpoint-interval, --resume)
+  std::string checkpoint_file;         // vacío => "<output_file>.ckpt"
+  double checkpoint_interval = 60.0;  // segundos entre checkpoints (0 => desactivados)
+  bool resume                = false;
+
+  // render por pasadas con tiempo límite en segundos (0 => desactivado, se usa samples_per_pixel)
+  double time_budget = 0.0;
+
+  // render progresivo: pasadas de pass_samples muestras por píxel hasta samples_per_pixel, con
+  // imágenes intermedias cada snapshot_every pasadas o cada snapshot_interval segundos
+  bool progressive         = false;
+  int pass_samples         = 1;
+  int snapshot_every       = 0;     // pasadas entre imágenes intermedias (0 => solo por tiempo)
+  double snapshot_interval = 10.0;  // segundos entre imágenes intermedias (0 => solo por pasadas)
+  std::string snapshot_file;        // vacío => "<output_file>.snapshot.ppm"
+
+  // contadores del render al terminar (--stats en texto, --stats-json en JSON)
+  bool stats      = false;
+  bool stats_json = false;
+
+  // fichero Chrome trace_event con la duración de cada fase (vacío => sin traza)
+  std::string trace_file;
+
+  // contadores hardware (perf_event_open) por fase al terminar
+  bool perf = false;
+
+  // mapa de coste por píxel (vacío => sin mapa); por defecto cuenta pruebas rayo-objeto y con
+  // --heatmap-metric time mide el tiempo de cada píxel
+  std::string heatmap_file;
+  bool heatmap_time = false;
+
+  // objetos con más pruebas de intersección que se listan al terminar (0 => sin perfil)
+  int object_profile = 0;
+
+  // asignaciones de memoria por fase; el programa falla si el bucle de render asigna
+  bool alloc_stats = false;
+
+  // sin indicador de progreso durante el render
+  bool quiet = false;
+
+  [[nodiscard]] std::string checkpoint_path() const {
+    return checkpoint_file.empty() ? output_file + ".ckpt" : checkpoint_file;
+  }
+
+  [[nodiscard]] std::string snapshot_path() const {
+    return snapshot_file.empty() ? output_file + ".snapshot.ppm" : snapshot_file;
+  }
+};
+
+// args incluye el nombre del programa en la posición 0 (como argv)
+bool parse_options(std::vector<std::string> const & args, RenderOptions & options);
+
+// texto de ayuda con los argumentos y opciones aceptados
+std::string usage(std::string const & program);
+
+#endif  // CLI_OPTIONS_HPP
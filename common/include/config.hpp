@@ -1,6 +1,23 @@
 #ifndef CONFIG_HPP
 #define CONFIG_HPP
 
+#include <cstdint>
+
+// Secuencia de la que salen el offset dentro del píxel y las direcciones de rebote (clave
+// 'sampler'): RANDOM usa los RNG sembrados con rayrngseed y materialrngseed (clave 'rng'); el
+// resto son secuencias de baja discrepancia deterministas indexadas por (píxel, muestra, dimensión)
+enum class SamplerType : std::uint8_t { RANDOM, HALTON, SOBOL, BLUE_NOISE };
+
+// Dirección de rebote de los materiales mate (clave 'mattescatter'): CUBE suma a la normal un
+// vector uniforme en el cubo [-1,1]^3 (el método original, para reproducir imágenes de
+// referencia); COSINE muestrea el hemisferio de la normal con densidad proporcional al coseno
+enum class MatteScatter : std::uint8_t { CUBE, COSINE };
+
+// Generador de los RNG sembrados con rayrngseed y materialrngseed (clave 'rng'): MT19937 es el
+// Mersenne-Twister original (para reproducir imágenes de referencia); XOSHIRO es xoshiro256+ de
+// varios carriles que genera los números por bloques (block_rng.hpp)
+enum class RngEngine : std::uint8_t { MT19937, XOSHIRO };
+
 // Definimos la estructura para todos los parámetros de configuración del proyecto[2]
 struct ConfigParams {
   int aspect_width  = 16;
@@ -17,11 +34,24 @@ struct ConfigParams {
   int ray_rng_seed               = 19;
   double background_dark_color_r = 0.25, background_dark_color_g = 0.5, background_dark_color_b = 1;
   double background_light_color_r = 1, background_light_color_g = 1, background_light_color_b = 1;
+  // muestreo adaptativo (desactivado si adaptive_max_samples == 0): cada píxel toma entre min y
+  // max muestras y se detiene cuando el error estándar relativo baja de adaptive_threshold
+  int adaptive_min_samples  = 0;
+  int adaptive_max_samples  = 0;
+  double adaptive_threshold = 0.0;
+  SamplerType sampler       = SamplerType::RANDOM;
+  MatteScatter matte_scatter = MatteScatter::CUBE;
+  RngEngine rng_engine       = RngEngine::MT19937;
 
   [[nodiscard]] int get_image_height() const {
     double aspect_ratio = static_cast<double>(aspect_width) / aspect_height;
     return static_cast<int>(image_width / aspect_ratio);
   }
+
+  [[nodiscard]] bool adaptive_sampling() const { return adaptive_max_samples > 0; }
+
+  // dos configuraciones son iguales si todos sus campos coinciden (usado al reanudar checkpoints)
+  [[nodiscard]] bool operator==(ConfigParams const &) const = default;
 };
 
 #endif  // CONFIG_HPP
@@ -1,10 +1,15 @@
 #ifndef CONFIG_PARSER_HPP
 #define CONFIG_PARSER_HPP
 
+#include <iosfwd>
 #include <string>
 #include "config.hpp"
 
 bool parse_config(const std::string &filename, ConfigParams &config_params);
+bool parse_config(std::istream &input, ConfigParams &config_params);
+
+// Escribe la configuración con el mismo formato que acepta parse_config (ida y vuelta exacta)
+void write_config(std::ostream &output, ConfigParams const &config_params);
 
 
 #endif // CONFIG_PARSER_HPP
\ No newline at end of file
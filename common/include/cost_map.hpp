@@ -0,0 +1,72 @@
+#ifndef RENDER_COST_MAP_HPP
+#define RENDER_COST_MAP_HPP
+
+#include "render_stats.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace render {
+
+  // MAPA DE COSTE POR PÍXEL (--heatmap out.ppm)
+  // Los bucles de píxeles leen probe() antes y después de cada píxel y acumulan la diferencia con
+  // add(); al terminar se normaliza por el máximo y se escribe con una rampa de color (negro ->
+  // morado -> rojo -> amarillo -> blanco). Métricas:
+  //   TESTS: pruebas rayo-objeto del hilo (contadores de --stats; requiere ENABLE_RENDER_STATS)
+  //   TIME:  nanosegundos de reloj monótono (incluye el ruido del sistema)
+  class CostMap {
+  public:
+    enum class Metric : std::uint8_t { TESTS, TIME };
+
+    CostMap(int width, int height, Metric metric);
+
+    [[nodiscard]] int width() const { return width_; }
+
+    [[nodiscard]] int height() const { return height_; }
+
+    // valor actual del contador de coste del hilo (solo tiene sentido la diferencia)
+    [[nodiscard]] std::uint64_t probe() const {
+      if (metric_ == Metric::TIME) {
+        auto const now = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+      }
+      auto const & tests = thread_stats().intersection_tests;
+      return std::accumulate(tests.begin(), tests.end(), std::uint64_t{0});
+    }
+
+    // suma el coste medido desde 'start' (un probe() anterior) al píxel (x, y)
+    void add(int x, int y, std::uint64_t start) { cost_[index(x, y)] += probe() - start; }
+
+    // suma un coste ya medido al píxel (x, y) (repartos de un coste medido para varios píxeles)
+    void add_cost(int x, int y, std::uint64_t cost) { cost_[index(x, y)] += cost; }
+
+    [[nodiscard]] std::uint64_t at(int x, int y) const { return cost_[index(x, y)]; }
+
+    [[nodiscard]] std::uint64_t max_cost() const;
+
+    // color de la rampa para t en [0, 1]
+    [[nodiscard]] static std::array<std::uint8_t, 3> ramp(double t);
+
+    // escribe el mapa normalizado en formato P6; last_row_first como en SnapshotWriter
+    bool write_ppm(std::string const & filename, bool last_row_first) const;
+
+  private:
+    [[nodiscard]] std::size_t index(int x, int y) const {
+      return static_cast<std::size_t>(y) * static_cast<std::size_t>(width_) +
+             static_cast<std::size_t>(x);
+    }
+
+    int width_;
+    int height_;
+    Metric metric_;
+    std::vector<std::uint64_t> cost_;
+  };
+
+}  // namespace render
+
+#endif  // RENDER_COST_MAP_HPP
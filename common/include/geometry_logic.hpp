@@ -9,18 +9,32 @@
 namespace render {
 
   // FUNCIONES DE COLISIÓN - DECLARACIONES
+  // las que solo buscan la distancia del impacto están instanciadas para double y float (la
+  // búsqueda del modo RENDER_FLOAT); el procesado del impacto se hace siempre en double
 
   // esfera
-  double hit_sphere(ray const & r, double t_min, double t_max, Sphere const * sph);
+  template <typename T>
+  T hit_sphere(basic_ray<T> const & r, T t_min, T t_max, Sphere const * sph);
   bool process_sphere_hit(ray const & r, double t, hit_record & rec, Sphere const * sph);
 
   // cilindro
-  double hit_cylinder_lateral(ray const & r, double t_min, double t_max, Cylinder const * cyl);
-  double hit_cylinder_caps(ray const & r, double t_min, double t_max, Cylinder const * cyl);
-  double hit_cylinder(ray const & r, double t_min, double t_max, Cylinder const * cyl);
+  template <typename T>
+  T hit_cylinder_lateral(basic_ray<T> const & r, T t_min, T t_max, Cylinder const * cyl);
+  template <typename T>
+  T hit_cylinder_caps(basic_ray<T> const & r, T t_min, T t_max, Cylinder const * cyl);
+  template <typename T>
+  T hit_cylinder(basic_ray<T> const & r, T t_min, T t_max, Cylinder const * cyl);
   bool process_cylinder_hit(ray const & r, double t, hit_record & rec, Cylinder const * cyl);
 
   // dispatch general
+  // distancia del impacto con el objeto en el rango o -1 si no lo hay (sin registro ni
+  // estadísticas)
+  template <typename T>
+  T hit_distance(basic_ray<T> const & r, std::array<T, 2> const & t_range,
+                 ObjectBase const * obj);
+  // registro del impacto con el objeto sin contarlo en las estadísticas de --stats
+  bool record_hit(ray const & r, std::array<double, 2> const & t_range, hit_record & rec,
+                  ObjectBase const * obj);
   bool hit_object(ray const & r, std::array<double, 2> const & t_range, hit_record & rec,
                   ObjectBase const * obj);
 
@@ -9,23 +9,24 @@ namespace render {
   // estructura material base a definir después (para definir punteros o referencias a ella)
   struct MaterialBase;
 
-  // ESTRUCTURA QUE DEFINE UNA INTERSECCIÓN ENTRE RAYO Y OBJETO
-  struct hit_record {
+  // ESTRUCTURA QUE DEFINE UNA INTERSECCIÓN ENTRE RAYO Y OBJETO (con vectores de componentes T)
+  template <typename T>
+  struct basic_hit_record {
     // DATOS A REGISTRAR
 
     // punto de intersección
-    point_vector intersect;
+    basic_vector<T> intersect;
     // vector normal a la superficie de un objeto
-    normal_vector normal;
+    basic_vector<T> normal;
     // distancia donde se produce la intersección del origen del rayo
-    double t{};
+    T t{};
     // indica si el rayo golpea la cara frontal
     bool front_face{};
     // puntero al material del objeto golpeado
     MaterialBase const * mat_pointer{};
 
     // función para ajustar la normal (necesaria para refracción)
-    void set_face_normal(ray const & r, normal_vector const & outward_normal) {
+    void set_face_normal(basic_ray<T> const & r, basic_vector<T> const & outward_normal) {
       // si el dot product es negativo el rayo va contra la normal
       front_face = dot(r.dir, outward_normal) < 0;
       // la normal siempre apunta hacia afuera del rayo incidente
@@ -33,6 +34,9 @@ namespace render {
     }
   };
 
+  // registro de doubles
+  using hit_record = basic_hit_record<double>;
+
 }  // namespace render
 
 #endif
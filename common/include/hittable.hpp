@@ -36,7 +36,17 @@ namespace render {
 
     void add(ObjectBase const * object) { objects.push_back(object); }
 
+    // en modo RENDER_FLOAT es hit_refined; si no, prueba todos los objetos en double
     bool hit(ray const & r, double t_min, double t_max, hit_record & rec) const override;
+
+    // busca el objeto más cercano con el rayo en float y calcula en double solo el impacto con
+    // ese objeto, de modo que t_min, la raíz elegida y la normal no dependen del redondeo en
+    // float. Si en double no hay impacto con él (la búsqueda en float lo ha encontrado por
+    // redondeo, p. ej. en la superficie de la que sale el rayo) se repite la búsqueda en double
+    bool hit_refined(ray const & r, double t_min, double t_max, hit_record & rec) const;
+
+  private:
+    bool hit_all(ray const & r, double t_min, double t_max, hit_record & rec) const;
   };
 
 }  // namespace render
@@ -5,17 +5,25 @@
 #include "materials.hpp"
 #include "math_utilities.hpp"
 #include "ray.hpp"
+#include "sampler.hpp"
 #include "vector.hpp"
 
 namespace render {
 
   // estructura utilizada para agrupar los punteros a los datos de salida y el contexto (RNG)
+  // si 'samples' no es nulo los rebotes toman de él sus números en lugar de 'rng' (clave sampler)
   struct ScatterIO {
     color_vector * attenuation;
     ray * scattered;
     RNG * rng;
+    SampleStream * samples     = nullptr;
+    MatteScatter matte_scatter = MatteScatter::CUBE;
   };
 
+  // dirección en el hemisferio de la normal unitaria 'normal' con densidad cos(theta) / pi, a
+  // partir de dos números uniformes en [0, 1)
+  direction_vector cosine_hemisphere(normal_vector const & normal, double u1, double u2);
+
   // FUNCIONES DE DISPERSIÓN - DECLARACIONES
   bool scatter_matte(hit_record const & rec, MatteMaterial const * mat, ScatterIO & io);
   bool scatter_metal(ray const & r_in, hit_record const & rec, MetalMaterial const * mat,
@@ -6,24 +6,27 @@
 
 // Material mate - reflectancia RGB[2]
 struct MatteMaterial : public render::MaterialBase {
-  render::MaterialType type = render::MATTE_TYPE;
+  MatteMaterial() : render::MaterialBase(render::MATTE_TYPE) { }
+
   std::string name;
-  double reflectance_r, reflectance_g, reflectance_b;
+  double reflectance_r{}, reflectance_g{}, reflectance_b{};
 };
 
 // Material metálico - reflectancia + difusión [2]
 struct MetalMaterial : public render::MaterialBase {
-  render::MaterialType type = render::METAL_TYPE;
+  MetalMaterial() : render::MaterialBase(render::METAL_TYPE) { }
+
   std::string name;
-  double reflectance_r, reflectance_g, reflectance_b;
-  double diffusion;
+  double reflectance_r{}, reflectance_g{}, reflectance_b{};
+  double diffusion{};
 };
 
 // Material refractivo - índice de refracción[2]
 struct RefractiveMaterial : public render::MaterialBase {
-  render::MaterialType type = render::REFRACTIVE_TYPE;
+  RefractiveMaterial() : render::MaterialBase(render::REFRACTIVE_TYPE) { }
+
   std::string name;
-  double refractive_index;
+  double refractive_index{};
 };
 
 #endif  // MATERIALS_HPP
@@ -1,22 +1,41 @@
 #ifndef RENDER_MATH_UTIL_HPP
 #define RENDER_MATH_UTIL_HPP
 
+#include "block_rng.hpp"
+#include "config.hpp"
 #include "vector.hpp"
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <optional>
 #include <random>
 
 namespace render {
 
   // CLASE QUE DEFINE LA GENERACIÓN DE NÚMEROS ALEATORIOS
+  // Con MT19937 cada número es una llamada a generate_canonical sobre el Mersenne-Twister; con
+  // XOSHIRO los números se generan de BLOCK_SIZE en BLOCK_SIZE con un BlockRNG y random_double
+  // solo lee el siguiente del bloque
   class RNG {
   private:
+    static constexpr std::size_t BLOCK_SIZE = 64;
+
     std::mt19937_64 generator;
+    std::optional<BlockRNG> block_generator;
+    // estado de block_generator antes de generar 'block' (lo que guarda un checkpoint)
+    std::optional<BlockRNG> block_origin;
+    std::array<double, BLOCK_SIZE> block{};
+    std::size_t next = BLOCK_SIZE;
 
   public:
-    explicit RNG(uint64_t seed);
+    explicit RNG(uint64_t seed, RngEngine engine = RngEngine::MT19937);
     [[nodiscard]] double random_double();
     [[nodiscard]] double random_double(double min, double max);
+
+    // estado completo del generador (posición en la secuencia) para checkpoints
+    void save_state(std::ostream & out) const;
+    bool load_state(std::istream & in);
   };
 
   // vector aleatorio con componentes en el rango [min, max]
@@ -3,12 +3,19 @@
 
 namespace render {
 
+  // material asociado al objeto (definido en material_base.hpp)
+  struct MaterialBase;
+
   // ENUM QUE IDENTIFICA EL TIPO DE OBJETO (necesario para el dispatching switch)
   enum ObjectType { SPHERE_TYPE, CYLINDER_TYPE };
 
   // ESTRUCTURA QUE DEFINE EL TIPO DE OBJETO SEGÚN EL ENUM
   struct ObjectBase {
     ObjectType type;
+    // material del objeto, se enlaza tras parsear la escena por nombre
+    MaterialBase const * material_ptr{};
+    // línea del fichero de escena que declara el objeto (0 = no viene de un fichero)
+    int source_line{};
 
     explicit ObjectBase(ObjectType t = SPHERE_TYPE) : type(t) { }
 
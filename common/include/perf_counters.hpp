@@ -0,0 +1,85 @@
+#ifndef RENDER_PERF_COUNTERS_HPP
+#define RENDER_PERF_COUNTERS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace render {
+
+  // CONTADORES HARDWARE (Linux perf_event_open) POR FASE DEL RENDER (--perf)
+  // Los contadores se abren para el hilo que llama a open() (el bucle de render) y se leen al
+  // entrar y salir de cada ScopedTimer de ese hilo, así que las fases son las mismas que las de
+  // --trace. Si el sistema no los permite (kernel sin perf, perf_event_paranoid, contenedores) o
+  // no es Linux, open() avisa y el informe solo muestra tiempos
+  class PerfCounters {
+  public:
+    enum Event : std::uint8_t {
+      CYCLES,
+      INSTRUCTIONS,
+      L1D_MISSES,
+      LLC_MISSES,
+      BRANCH_MISSES,
+      EVENT_COUNT
+    };
+
+    using Reading = std::array<std::uint64_t, EVENT_COUNT>;
+
+    static PerfCounters & instance();
+
+    ~PerfCounters();
+
+    PerfCounters(PerfCounters const &)             = delete;
+    PerfCounters & operator=(PerfCounters const &) = delete;
+    PerfCounters(PerfCounters &&)                  = delete;
+    PerfCounters & operator=(PerfCounters &&)      = delete;
+
+    // activa la medida; devuelve false si no hay ningún contador disponible (solo tiempos)
+    bool open();
+
+    [[nodiscard]] bool active() const { return active_; }
+
+    // ¿mide los contadores del hilo actual? (solo el hilo que llamó a open())
+    [[nodiscard]] bool measures_this_thread() const {
+      return active_ and std::this_thread::get_id() == owner_;
+    }
+
+    [[nodiscard]] bool available(Event event) const {
+      return fds_[static_cast<std::size_t>(event)] >= 0;
+    }
+
+    // valores actuales de los contadores del hilo (escalados si el kernel los multiplexa)
+    [[nodiscard]] Reading read() const;
+
+    // acumula lo medido en una ejecución de la fase 'name'
+    void add_phase(char const * name, Reading const & delta, std::chrono::duration<double> wall);
+
+    // tabla por fase con IPC y fallos por rayo ('rays' = rayos primarios del render)
+    void write_report(std::ostream & out, std::uint64_t rays) const;
+
+  private:
+    PerfCounters();
+
+    struct PhaseTotals {
+      std::string name;
+      std::uint64_t calls = 0;
+      double seconds      = 0.0;
+      Reading values{};
+    };
+
+    bool active_ = false;
+    std::thread::id owner_;
+    std::array<int, EVENT_COUNT> fds_{};
+    mutable std::mutex mutex_;
+    std::vector<PhaseTotals> phases_;  // en orden de primera aparición
+  };
+
+}  // namespace render
+
+#endif  // RENDER_PERF_COUNTERS_HPP
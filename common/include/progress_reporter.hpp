@@ -0,0 +1,68 @@
+#ifndef RENDER_PROGRESS_REPORTER_HPP
+#define RENDER_PROGRESS_REPORTER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <thread>
+
+namespace render {
+
+  // INDICADOR DE PROGRESO FUERA DEL HILO DE RENDER
+  // El bucle de render solo suma con advance() a dos contadores atómicos (sin mutex ni E/S); un
+  // hilo de baja prioridad los lee a ritmo fijo y escribe en std::cerr el porcentaje, el tiempo
+  // estimado restante y los rayos por segundo. Con quiet no se crea el hilo y no se escribe nada
+  class ProgressReporter {
+  public:
+    static constexpr std::chrono::milliseconds REPORT_PERIOD{500};
+
+    // total: unidades de trabajo esperadas (0 => desconocido: sin porcentaje ni ETA)
+    // unit: nombre de la unidad en el mensaje (literal, p.ej. "filas")
+    ProgressReporter(std::uint64_t total, char const * unit, bool quiet);
+    ~ProgressReporter();
+
+    ProgressReporter(ProgressReporter const &)             = delete;
+    ProgressReporter & operator=(ProgressReporter const &) = delete;
+    ProgressReporter(ProgressReporter &&)                  = delete;
+    ProgressReporter & operator=(ProgressReporter &&)      = delete;
+
+    // 'work' unidades terminadas en las que se trazaron 'rays' rayos primarios
+    void advance(std::uint64_t work, std::uint64_t rays) {
+      done_.fetch_add(work, std::memory_order_relaxed);
+      rays_.fetch_add(rays, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::uint64_t done() const { return done_.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] std::uint64_t rays() const { return rays_.load(std::memory_order_relaxed); }
+
+    // detiene el hilo y escribe la línea final; se puede llamar varias veces
+    void finish();
+
+    // escribe una línea de progreso (sin salto de línea) con los valores actuales
+    void write_line(std::ostream & out) const;
+
+  private:
+    void run();
+
+    std::uint64_t total_;
+    char const * unit_;
+    std::chrono::steady_clock::time_point start_;
+    std::atomic<std::uint64_t> done_{0};
+    std::atomic<std::uint64_t> rays_{0};
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    bool finished_ = false;
+
+    // último miembro: el hilo arranca cuando el resto ya está construido
+    std::thread worker_;
+  };
+
+}  // namespace render
+
+#endif  // RENDER_PROGRESS_REPORTER_HPP
@@ -5,24 +5,28 @@
 
 namespace render {
 
-  // CLASE QUE DEFINE A UN RAYO
-  class ray {
+  // CLASE QUE DEFINE A UN RAYO (con vectores de componentes T)
+  template <typename T>
+  class basic_ray {
   public:
     // vectores que representan origen y dirección respectivamente
-    point_vector orig;
-    direction_vector dir;
+    basic_vector<T> orig;
+    basic_vector<T> dir;
 
     // para crear instancia se deberan recibir 2 vectores que se guardan en los ya declarados
-    ray() = default;
+    basic_ray() = default;
 
-    ray(point_vector const & origin, direction_vector const & direction)
+    basic_ray(basic_vector<T> const & origin, basic_vector<T> const & direction)
         : orig(origin), dir(direction) { }
 
     // FUNCIÓN PARA CALCULAR POSICIÓN A LA DISTANCIA t DEL ORIGEN, A LO LARGO DE LA DIRECCIÓN
     // P(t) = origen + t*dirección
-    [[nodiscard]] point_vector at(double t) const { return orig + t * dir; }
+    [[nodiscard]] basic_vector<T> at(T t) const { return orig + t * dir; }
   };
 
+  // rayo de doubles
+  using ray = basic_ray<double>;
+
 }  // namespace render
 
 #endif
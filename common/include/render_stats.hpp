@@ -0,0 +1,147 @@
+#ifndef RENDER_RENDER_STATS_HPP
+#define RENDER_RENDER_STATS_HPP
+
+#include "material_base.hpp"
+#include "object_base.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// CONTADORES DEL CAMINO CALIENTE (--stats)
+// Cada hilo incrementa su propia copia (thread_local, sin atómicos ni mutex) y las copias se suman
+// al final con collect_stats(). Con la opción de CMake ENABLE_RENDER_STATS=OFF no se define
+// RENDER_STATS_ENABLED y RENDER_STAT(...) no genera código: los contadores desaparecen del render
+#ifdef RENDER_STATS_ENABLED
+  #define RENDER_STAT(expr) (expr)
+#else
+  #define RENDER_STAT(expr) static_cast<void>(0)
+#endif
+
+namespace render {
+
+  // el perfil por objeto (--object-profile) se activa en tiempo de ejecución: cada prueba indexa
+  // un vector por línea de escena, más caro que los contadores fijos
+  inline std::atomic<bool> object_profile_active{false};
+
+  // pruebas y aciertos de un objeto de la escena
+  struct ObjectCounts {
+    std::uint64_t tests{};
+    std::uint64_t hits{};
+  };
+
+  // ESTRUCTURA CON LOS CONTADORES DE UN HILO (o la suma de todos)
+  struct RenderStats {
+    // los rebotes más profundos se acumulan en la última posición
+    static constexpr std::size_t MAX_TRACKED_DEPTH = 32;
+    static constexpr std::size_t OBJECT_TYPES      = 2;  // SPHERE_TYPE, CYLINDER_TYPE
+    static constexpr std::size_t MATERIAL_TYPES    = 3;  // MATTE_TYPE, METAL_TYPE, REFRACTIVE_TYPE
+
+    std::uint64_t primary_rays{};
+    // rayos secundarios por rebote (posición 1 = primer rebote; la 0 no se usa)
+    std::array<std::uint64_t, MAX_TRACKED_DEPTH> secondary_rays{};
+    // pruebas rayo-objeto y cuántas acertaron, por tipo de objeto
+    std::array<std::uint64_t, OBJECT_TYPES> intersection_tests{};
+    std::array<std::uint64_t, OBJECT_TYPES> intersection_hits{};
+    // rayos que golpean algún objeto de la escena frente a los que llegan al fondo
+    std::uint64_t ray_hits{};
+    std::uint64_t ray_misses{};
+    // resultado de la dispersión por tipo de material
+    std::array<std::uint64_t, MATERIAL_TYPES> scattered{};
+    std::array<std::uint64_t, MATERIAL_TYPES> absorbed{};
+    // caminos cortados por max_depth
+    std::uint64_t max_depth_terminations{};
+    // pruebas por objeto, indexadas por ObjectBase::source_line (solo con --object-profile;
+    // enable_object_profile lo dimensiona antes del render)
+    std::vector<ObjectCounts> object_counts;
+
+    void merge(RenderStats const & other);
+
+    // anotaciones usadas desde los kernels (inline: se llaman por rayo y por objeto)
+    void count_ray(int bounce) {
+      if (bounce == 0) {
+        ++primary_rays;
+        return;
+      }
+      auto const idx = static_cast<std::size_t>(bounce);
+      ++secondary_rays[idx < MAX_TRACKED_DEPTH ? idx : MAX_TRACKED_DEPTH - 1];
+    }
+
+    void count_intersection(ObjectType type, bool hit) {
+      auto const idx = static_cast<std::size_t>(type);
+      ++intersection_tests[idx];
+      intersection_hits[idx] += hit ? 1U : 0U;
+    }
+
+    void count_object(int source_line, bool hit) {
+      auto const idx = static_cast<std::size_t>(source_line);
+      if (!object_profile_active.load(std::memory_order_relaxed) or idx >= object_counts.size()) {
+        return;
+      }
+      ++object_counts[idx].tests;
+      object_counts[idx].hits += hit ? 1U : 0U;
+    }
+
+    void count_scatter(MaterialType type, bool bounced) {
+      auto const idx = static_cast<std::size_t>(type);
+      ++(bounced ? scattered : absorbed)[idx];
+    }
+
+    void write_text(std::ostream & out) const;
+    void write_json(std::ostream & out) const;
+  };
+
+  // registro del contador de un hilo: lo da de alta al crearse y suma sus valores al total de
+  // hilos terminados al destruirse. Los registros forman una lista enlazada intrusiva para que dar
+  // de alta un hilo (dentro de su primera fila) no asigne memoria
+  class ThreadStatsSlot {
+  public:
+    ThreadStatsSlot();
+    ~ThreadStatsSlot();
+
+    ThreadStatsSlot(ThreadStatsSlot const &)             = delete;
+    ThreadStatsSlot & operator=(ThreadStatsSlot const &) = delete;
+    ThreadStatsSlot(ThreadStatsSlot &&)                  = delete;
+    ThreadStatsSlot & operator=(ThreadStatsSlot &&)      = delete;
+
+    RenderStats stats;
+    ThreadStatsSlot * prev = nullptr;
+    ThreadStatsSlot * next = nullptr;
+  };
+
+  // contadores del hilo actual
+  inline RenderStats & thread_stats() {
+    thread_local ThreadStatsSlot slot;
+    return slot.stats;
+  }
+
+  // activa el perfil por objeto con un contador por línea de escena hasta max_source_line en el
+  // hilo actual. Se llama antes del render para que count_object no asigne memoria en el bucle
+  void enable_object_profile(int max_source_line);
+
+  // suma de los contadores de todos los hilos; se llama cuando ya no quedan hilos renderizando
+  [[nodiscard]] RenderStats collect_stats();
+
+  // escribe el total (collect_stats) en texto o JSON; si los contadores no se compilaron solo
+  // avisa por std::cerr
+  void write_stats_report(std::ostream & out, bool json);
+
+  // los top_n objetos con más pruebas (collect_stats), con la línea de scene_file que los declara
+  void write_object_profile(std::ostream & out, std::string const & scene_file,
+                            std::size_t top_n);
+
+  // ¿se compilaron los contadores? (si no, --stats solo muestra un aviso)
+  constexpr bool stats_enabled() {
+#ifdef RENDER_STATS_ENABLED
+    return true;
+#else
+    return false;
+#endif
+  }
+
+}  // namespace render
+
+#endif  // RENDER_RENDER_STATS_HPP
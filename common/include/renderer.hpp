@@ -0,0 +1,45 @@
+#ifndef RENDER_RENDERER_HPP
+#define RENDER_RENDERER_HPP
+
+#include "cli_options.hpp"
+#include "config.hpp"
+#include "scene_parser.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace render {
+
+  // Entrada de un render: opciones, configuración y escena con los materiales ya enlazados
+  // (link_materials). start_time es el arranque del programa, desde el que cuenta --time-budget
+  struct RenderJob {
+    RenderOptions const & options;
+    ConfigParams const & config;
+    SceneOutput const & scene;
+    std::chrono::steady_clock::time_point start_time;
+  };
+
+  // INTERFAZ DE LOS BACKENDS DE RENDER (aos::AOSRenderer y soa::SOARenderer)
+  // render() traza la escena, escribe la imagen en options.output_file (y el mapa de coste de
+  // --heatmap) y deja en primary_rays las muestras trazadas para el informe de --perf. Devuelve
+  // false si algo falla, con el error ya escrito en std::cerr
+  class Renderer {
+  public:
+    virtual bool render(RenderJob const & job, std::uint64_t & primary_rays) = 0;
+    virtual ~Renderer()                                                      = default;
+  };
+
+  // crea el backend pedido (renderer_factory.cpp, en renderer_lib junto con las dos librerías)
+  [[nodiscard]] std::unique_ptr<Renderer> make_renderer(Backend backend);
+
+  // Programa completo de render-aos y render-soa: opciones, configuración y escena, render con el
+  // backend de --backend (default_backend si no se indica) e informes de --stats, --perf,
+  // --object-profile, --alloc-stats y --trace. Devuelve el código de salida del programa
+  int run_renderer(std::vector<std::string> const & args, Backend default_backend);
+
+}  // namespace render
+
+#endif  // RENDER_RENDERER_HPP
@@ -0,0 +1,55 @@
+#ifndef RENDER_RUNNING_STATS_HPP
+#define RENDER_RUNNING_STATS_HPP
+
+#include "vector.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace render {
+
+  // luminancia relativa (Rec. 709) de un color lineal; es la magnitud que se usa para estimar el
+  // error de un píxel en el muestreo adaptativo
+  inline double luminance(color_vector const & c) {
+    return 0.2126 * c.r() + 0.7152 * c.g() + 0.0722 * c.b();
+  }
+
+  // CLASE QUE ACUMULA MEDIA Y VARIANZA DE UNA SECUENCIA (algoritmo de Welford)
+  // numéricamente estable y de una sola pasada: no hace falta guardar las muestras
+  class RunningStats {
+  public:
+    void add(double value) {
+      ++count_;
+      double const delta  = value - mean_;
+      mean_              += delta / static_cast<double>(count_);
+      m2_                += delta * (value - mean_);
+    }
+
+    [[nodiscard]] long count() const { return count_; }
+
+    [[nodiscard]] double mean() const { return mean_; }
+
+    // varianza muestral (insesgada)
+    [[nodiscard]] double variance() const {
+      return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0;
+    }
+
+    // error estándar estimado de la media
+    [[nodiscard]] double standard_error() const {
+      return count_ > 1 ? std::sqrt(variance() / static_cast<double>(count_)) : 0.0;
+    }
+
+    // el error es aceptable si no supera 'threshold' veces la media (con un suelo para que los
+    // píxeles casi negros no exijan un error absoluto imposible)
+    [[nodiscard]] bool converged(double threshold, double floor = 1e-2) const {
+      return standard_error() <= threshold * std::max(mean_, floor);
+    }
+
+  private:
+    long count_  = 0;
+    double mean_ = 0.0;
+    double m2_   = 0.0;
+  };
+
+}  // namespace render
+
+#endif  // RENDER_RUNNING_STATS_HPP
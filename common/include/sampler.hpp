@@ -0,0 +1,125 @@
+#ifndef RENDER_SAMPLER_HPP
+#define RENDER_SAMPLER_HPP
+
+#include "config.hpp"
+#include "math_utilities.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace render {
+
+  // nombre de la secuencia en el fichero de configuración ("random", "halton", "sobol",
+  // "bluenoise") y su inversa
+  [[nodiscard]] char const * sampler_name(SamplerType type);
+  [[nodiscard]] std::optional<SamplerType> parse_sampler_type(std::string_view name);
+
+  // muestra 'index' del píxel (x, y)
+  struct SamplePoint {
+    int x;
+    int y;
+    std::uint32_t index;
+  };
+
+  // MÁSCARA DE RUIDO AZUL (void-and-cluster de Ulichney sobre un tile toroidal)
+  // Cada celda guarda su rango 0..CELLS-1: los umbrales bajos quedan repartidos sin grumos, de
+  // forma que el error de muestreo de píxeles vecinos se concentra en frecuencias altas
+  class BlueNoiseMask {
+  public:
+    static constexpr int SIZE          = 64;
+    static constexpr std::size_t CELLS = static_cast<std::size_t>(SIZE) * SIZE;
+
+    // la máscara se genera una sola vez, la primera vez que se pide
+    static BlueNoiseMask const & instance();
+
+    [[nodiscard]] std::uint16_t rank(int x, int y) const {
+      return ranks_[static_cast<std::size_t>(y & (SIZE - 1)) * SIZE +
+                    static_cast<std::size_t>(x & (SIZE - 1))];
+    }
+
+  private:
+    BlueNoiseMask();
+
+    std::array<std::uint16_t, CELLS> ranks_{};
+  };
+
+  // SECUENCIAS DE BAJA DISCREPANCIA
+  // get() no tiene estado: el mismo (píxel, muestra, dimensión) da siempre el mismo valor, por lo
+  // que el orden de los píxeles, las pasadas progresivas y los checkpoints no cambian la imagen.
+  //   HALTON:     inverso radical en base primo (una base por dimensión) con los dígitos
+  //               desplazados al azar por píxel
+  //   SOBOL:      Sobol de 4 dimensiones con scrambling de Owen (hash de Laine-Karras) y el
+  //               índice barajado por píxel; cada grupo de 4 dimensiones usa otra semilla
+  //   BLUE_NOISE: máscara de ruido azul desplazada por dimensión, rotada por muestra con la
+  //               secuencia aditiva de la razón áurea
+  // Con RANDOM get() devuelve un hash uniforme del punto, sin estructura; el render no lo usa y
+  // sigue sacando los números de los RNG (ver SampleStream) para conservar las imágenes de siempre
+  class Sampler {
+  public:
+    Sampler(SamplerType type, std::uint64_t seed);
+
+    [[nodiscard]] SamplerType type() const { return type_; }
+
+    // valor en [0, 1) de la dimensión 'dimension' de la muestra 'point'
+    [[nodiscard]] double get(SamplePoint const & point, std::uint32_t dimension) const {
+      return get(point, pixel_seed(point), dimension);
+    }
+
+    // semilla del píxel de 'point', común a todas sus muestras y dimensiones (SampleStream la
+    // calcula una sola vez por muestra)
+    [[nodiscard]] std::uint64_t pixel_seed(SamplePoint const & point) const;
+
+    // get() con la semilla del píxel ya calculada
+    [[nodiscard]] double get(SamplePoint const & point, std::uint64_t pixel_seed,
+                             std::uint32_t dimension) const;
+
+  private:
+    [[nodiscard]] double halton(SamplePoint const & point, std::uint64_t pixel_seed,
+                                std::uint32_t dimension) const;
+    [[nodiscard]] double sobol(SamplePoint const & point, std::uint64_t pixel_seed,
+                               std::uint32_t dimension) const;
+    [[nodiscard]] double blue_noise(SamplePoint const & point, std::uint32_t dimension) const;
+
+    SamplerType type_;
+    std::uint64_t seed_;
+    BlueNoiseMask const * mask_ = nullptr;
+  };
+
+  // NÚMEROS DE UNA MUESTRA, EN EL ORDEN EN QUE SE PIDEN
+  // Con un RNG repite exactamente la secuencia de random_double(); con un Sampler recorre las
+  // dimensiones consecutivas del punto (primero el offset en el píxel, luego los rebotes)
+  class SampleStream {
+  public:
+    explicit SampleStream(RNG & rng) : rng_(&rng) { }
+
+    SampleStream(Sampler const & sampler, SamplePoint const & point,
+                 std::uint32_t first_dimension = 0)
+        : sampler_(&sampler), point_(point), pixel_seed_(sampler.pixel_seed(point)),
+          dimension_(first_dimension) { }
+
+    [[nodiscard]] double next() {
+      return rng_ != nullptr ? rng_->random_double()
+                             : sampler_->get(point_, pixel_seed_, dimension_++);
+    }
+
+    [[nodiscard]] double next(double min, double max) { return min + (max - min) * next(); }
+
+    // siguiente dimensión que se pedirá (para continuar el punto en otro SampleStream)
+    [[nodiscard]] std::uint32_t dimension() const { return dimension_; }
+
+  private:
+    RNG * rng_                = nullptr;
+    Sampler const * sampler_  = nullptr;
+    SamplePoint point_        = {.x = 0, .y = 0, .index = 0};
+    std::uint64_t pixel_seed_ = 0;
+    std::uint32_t dimension_  = 0;
+  };
+
+  // vector con componentes en [min, max] tomadas de los siguientes tres números del flujo
+  direction_vector random_vec(SampleStream & samples, double min = -1.0, double max = 1.0);
+
+}  // namespace render
+
+#endif  // RENDER_SAMPLER_HPP
@@ -0,0 +1,57 @@
+#ifndef RENDER_SCATTER_BATCH_HPP
+#define RENDER_SCATTER_BATCH_HPP
+
+#include "config.hpp"
+#include "material_base.hpp"
+#include "materials.hpp"
+#include "vector.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace render {
+
+  // números uniformes que puede consumir un rebote (mate cubo y metal: uno por eje)
+  constexpr std::size_t MAX_SCATTER_UNIFORMS = 3;
+
+  // LOTE DE IMPACTOS DE UN MISMO MATERIAL EN FORMATO SOA
+  // Se usan las posiciones 0..size-1 de cada columna.
+  // Entrada: dirección del rayo incidente, normal de hit_record (orientada contra el rayo),
+  // front_face y los números uniformes en [0, 1) que el material consume por impacto
+  // (scatter_uniforms), en el orden en que los pediría scatter.
+  // Salida: dirección dispersada y si el rayo sigue. El origen del rayo dispersado es el punto de
+  // impacto, que el lote no necesita
+  struct ScatterBatch {
+    explicit ScatterBatch(std::size_t capacity);
+
+    std::size_t size = 0;
+    std::vector<double> dir_x, dir_y, dir_z;
+    std::vector<double> normal_x, normal_y, normal_z;
+    std::vector<std::uint8_t> front_face;
+    std::array<std::vector<double>, MAX_SCATTER_UNIFORMS> uniforms;
+    std::vector<double> out_x, out_y, out_z;
+    std::vector<std::uint8_t> bounced;
+  };
+
+  // números uniformes por impacto que consume la dispersión del material
+  [[nodiscard]] std::size_t scatter_uniforms(MaterialBase const & mat, MatteScatter matte_scatter);
+
+  // KERNELS POR MATERIAL
+  // Bucles sobre las columnas sin llamadas virtuales ni ramas por impacto (las ramas de la
+  // versión por rayo son selecciones), con el mismo resultado bit a bit que scatter_matte,
+  // scatter_metal y scatter_refractive con los mismos números. Devuelven la atenuación, que solo
+  // depende del material y es la misma para todo el lote
+  color_vector scatter_matte_batch(MatteMaterial const & mat, MatteScatter matte_scatter,
+                                   ScatterBatch & batch);
+  color_vector scatter_metal_batch(MetalMaterial const & mat, ScatterBatch & batch);
+  color_vector scatter_refractive_batch(RefractiveMaterial const & mat, ScatterBatch & batch);
+
+  // elige el kernel por el tipo del material (una vez por lote) y cuenta los rebotes en --stats
+  color_vector scatter_batch(MaterialBase const & mat, MatteScatter matte_scatter,
+                             ScatterBatch & batch);
+
+}  // namespace render
+
+#endif  // RENDER_SCATTER_BATCH_HPP
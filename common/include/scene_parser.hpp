@@ -24,6 +24,9 @@ struct SceneOutput {
 
 bool parse_scene(std::string const & filename, SceneOutput & out);
 
+// Asigna a cada objeto el puntero a su material (buscado por nombre); falla si alguno no existe
+bool link_materials(SceneOutput & scene);
+
 #endif  // SCENE_PARSER_HPP
 
 // Falta implementar comprobación que los objetos referencian materiales ya definidos
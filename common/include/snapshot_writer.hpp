@@ -0,0 +1,63 @@
+#ifndef RENDER_SNAPSHOT_WRITER_HPP
+#define RENDER_SNAPSHOT_WRITER_HPP
+
+#include "accumulation_buffer.hpp"
+#include "tone_mapping.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace render {
+
+  // CLASE QUE ESCRIBE IMÁGENES INTERMEDIAS (PPM) DE UN RENDER EN CURSO
+  // submit() solo copia el buffer de acumulación bajo el mutex; la cuantización y la escritura
+  // del fichero se hacen en un hilo propio sobre una segunda copia (doble buffer), de forma que el
+  // bucle de render no espera al disco. Si llega una copia nueva antes de que se haya escrito la
+  // anterior, se sustituye: solo interesa la imagen más reciente
+  class SnapshotWriter {
+  public:
+    // last_row_first: escribe la fila height-1 del buffer en primer lugar (mismo orden que
+    // AOSImage::write_ppm), para que la imagen intermedia coincida con la final
+    SnapshotWriter(std::string filename, double gamma, bool last_row_first);
+    ~SnapshotWriter();
+
+    SnapshotWriter(SnapshotWriter const &)             = delete;
+    SnapshotWriter & operator=(SnapshotWriter const &) = delete;
+    SnapshotWriter(SnapshotWriter &&)                  = delete;
+    SnapshotWriter & operator=(SnapshotWriter &&)      = delete;
+
+    // encola una copia del estado actual del buffer
+    void submit(AccumulationBuffer const & buffer);
+
+    // escribe la copia pendiente (si la hay) y termina el hilo; se llama también al destruir
+    void finish();
+
+    // número de imágenes escritas correctamente
+    [[nodiscard]] int written() const { return written_.load(); }
+
+  private:
+    std::string filename_;
+    GammaLUT lut_;
+    bool last_row_first_;
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::optional<AccumulationBuffer> pending_;   // última copia recibida (protegida por mutex_)
+    std::optional<AccumulationBuffer> encoding_;  // copia que está escribiendo el hilo
+    bool has_pending_ = false;
+    bool stopping_    = false;
+    std::atomic<int> written_{0};
+
+    // se declara el último para que arranque con el resto de miembros ya construidos
+    std::thread worker_;
+
+    void run();
+    [[nodiscard]] bool write_snapshot(AccumulationBuffer const & buffer) const;
+  };
+
+}  // namespace render
+
+#endif  // RENDER_SNAPSHOT_WRITER_HPP
@@ -0,0 +1,44 @@
+#ifndef RENDER_TONE_MAPPING_HPP
+#define RENDER_TONE_MAPPING_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace render {
+
+  // FILA DE COLOR LINEAL (un array por canal, como los planos de SOAImage)
+  struct LinearRow {
+    std::span<double const> r;
+    std::span<double const> g;
+    std::span<double const> b;
+  };
+
+  // CLASE QUE DEFINE LA ETAPA FINAL DE COLOR: CLAMP + CORRECCIÓN GAMMA + CUANTIZACIÓN A BYTE
+  // Sustituye std::pow por una tabla indexada por sqrt(valor): en ese dominio la curva
+  // x^(1/gamma) = s^(2/gamma) es casi lineal, así que 4096 entradas bastan para que el byte
+  // resultante difiera como mucho en 1 del cálculo exacto floor(255 * pow(x, 1/gamma)) para
+  // gamma <= 3 (comprobado en utcommon/test_tone_mapping.cpp)
+  class GammaLUT {
+  public:
+    static constexpr std::size_t LUT_SIZE = 4'096;
+
+    explicit GammaLUT(double gamma);
+
+    [[nodiscard]] double gamma() const { return gamma_; }
+
+    // un único valor lineal (se satura a [0, 1]; NaN se trata como 0)
+    [[nodiscard]] std::uint8_t to_byte(double value) const;
+
+    // convierte una fila completa de un canal; out debe tener al menos linear.size() elementos
+    void quantize(std::span<double const> linear, std::span<std::uint8_t> out) const;
+
+  private:
+    double gamma_;
+    std::array<std::uint8_t, LUT_SIZE + 1> table_{};
+  };
+
+}  // namespace render
+
+#endif  // RENDER_TONE_MAPPING_HPP
@@ -0,0 +1,83 @@
+#ifndef RENDER_TRACE_HPP
+#define RENDER_TRACE_HPP
+
+#include "alloc_counter.hpp"
+#include "perf_counters.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace render {
+
+  // REGISTRO DE FASES DEL RENDER EN FORMATO CHROME TRACE_EVENT (--trace out.json)
+  // El fichero se abre en Perfetto o chrome://tracing: cada ScopedTimer es un evento completo
+  // ("ph": "X") en la pista de su hilo. Mientras no se llama a enable() los temporizadores solo
+  // comprueban un flag
+  class TraceRecorder {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    struct Event {
+      char const * name;      // literales: el registro guarda solo el puntero
+      char const * category;
+      clock::time_point start;
+      clock::time_point end;
+      int thread;
+      std::optional<std::int64_t> arg;  // p.ej. número de fila
+    };
+
+    static TraceRecorder & instance();
+
+    void enable();
+
+    [[nodiscard]] bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void record(Event const & event);
+
+    // índice pequeño y estable del hilo actual (0 = primer hilo que registra)
+    [[nodiscard]] static int thread_index();
+
+    // escribe todos los eventos registrados hasta ahora
+    bool write(std::string const & filename) const;
+
+  private:
+    TraceRecorder() = default;
+
+    std::atomic<bool> enabled_{false};
+    clock::time_point origin_;
+    mutable std::mutex mutex_;
+    std::vector<Event> events_;
+  };
+
+  // TEMPORIZADOR DE ÁMBITO: registra el intervalo entre su construcción y su destrucción en la
+  // traza y, con --perf y --alloc-stats, los contadores hardware y las asignaciones de la fase
+  class ScopedTimer {
+  public:
+    explicit ScopedTimer(char const * name, char const * category = "render");
+    ScopedTimer(char const * name, char const * category, std::int64_t arg);
+    ~ScopedTimer();
+
+    ScopedTimer(ScopedTimer const &)             = delete;
+    ScopedTimer & operator=(ScopedTimer const &) = delete;
+    ScopedTimer(ScopedTimer &&)                  = delete;
+    ScopedTimer & operator=(ScopedTimer &&)      = delete;
+
+  private:
+    bool trace_active_;
+    bool perf_active_;
+    bool alloc_active_;
+    char const * name_;
+    char const * category_;
+    std::optional<std::int64_t> arg_;
+    TraceRecorder::clock::time_point start_;
+    PerfCounters::Reading perf_start_{};
+    AllocationCount alloc_start_;
+  };
+
+}  // namespace render
+
+#endif  // RENDER_TRACE_HPP
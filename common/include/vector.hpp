@@ -1,83 +1,179 @@
 #ifndef RENDER_VECTOR_HPP
 #define RENDER_VECTOR_HPP
 
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+// Escalar de los buffers de rayos y de la búsqueda de intersecciones (opción RENDER_FLOAT de
+// CMake): 0 lo hace todo en double; 1 usa float para las previsualizaciones, y los impactos
+// encontrados se recalculan en double (hittable.hpp, wavefront.hpp)
+#ifndef RENDER_FLOAT
+  #define RENDER_FLOAT 0
+#endif
+
+// Disposición de los vectores (opción RENDER_VECTOR_PADDED de CMake): 0 guarda x, y, z; 1 añade
+// un cuarto componente de relleno a 0 y alinea a 4 componentes, de forma que cada operación por
+// componentes es una sola instrucción AVX de 4 doubles
+#ifndef RENDER_VECTOR_PADDED
+  #define RENDER_VECTOR_PADDED 0
+#endif
 
 namespace render {
 
-  // CLASE QUE DEFINE A UN VECTOR
-  class vector {
+  using real = std::conditional_t<RENDER_FLOAT != 0, float, double>;
+
+  constexpr bool SINGLE_PRECISION = RENDER_FLOAT != 0;
+
+  // componentes guardados por vector con la disposición elegida
+  constexpr std::size_t VECTOR_STORAGE = RENDER_VECTOR_PADDED != 0 ? 4 : 3;
+
+  // CLASE QUE DEFINE A UN VECTOR (con componentes de tipo T: double, o float en los buffers del
+  // modo RENDER_FLOAT; y Storage componentes guardados: 3, o 4 con el relleno a 0)
+  // Es el mismo tipo en common, AOS y SOA. Todo está en la cabecera y es constexpr, para que el
+  // compilador pueda inlinar la aritmética del camino caliente sin LTO. Las operaciones por
+  // componentes recorren los Storage componentes (el relleno sigue a 0); dot, las magnitudes y
+  // near_zero solo suman x, y, z en ese orden, así que el resultado es el mismo bit a bit con las
+  // dos disposiciones
+  template <typename T, std::size_t Storage = VECTOR_STORAGE>
+  class alignas(Storage == 4 ? 4 * sizeof(T) : alignof(T)) basic_vector {
+    static_assert(Storage == 3 or Storage == 4, "basic_vector guarda 3 o 4 componentes");
+
   public:
+    using value_type = T;
+
     // constructores
-    vector() : x{0}, y{0}, z{0} { }
+    constexpr basic_vector() = default;
 
-    vector(double cx, double cy, double cz) : x{cx}, y{cy}, z{cz} { }
+    constexpr basic_vector(T cx, T cy, T cz) : c{cx, cy, cz} { }
 
     // DEFINICION DE FUNCIONES (las dos devuelven x, y o z por valor pero diferenciamos por
     // semántica)
 
     // devuelve posición
-    [[nodiscard]] double get_x() const { return x; }
+    [[nodiscard]] constexpr T get_x() const { return c[0]; }
 
-    [[nodiscard]] double get_y() const { return y; }
+    [[nodiscard]] constexpr T get_y() const { return c[1]; }
 
-    [[nodiscard]] double get_z() const { return z; }
+    [[nodiscard]] constexpr T get_z() const { return c[2]; }
 
     // devuelve color
-    [[nodiscard]] double r() const { return x; }
+    [[nodiscard]] constexpr T r() const { return c[0]; }
 
-    [[nodiscard]] double g() const { return y; }
+    [[nodiscard]] constexpr T g() const { return c[1]; }
 
-    [[nodiscard]] double b() const { return z; }
+    [[nodiscard]] constexpr T b() const { return c[2]; }
 
     // OPERADORES DE VECTORES
 
     // cálculo del inverso
-    vector operator-() const { return {-x, -y, -z}; }
+    constexpr basic_vector operator-() const {
+      return map(*this, [](T a) { return -a; });
+    }
+
+    // lectura de una posición del vector (con comprobación de rango)
+    constexpr T operator[](int i) const { return c[checked_index(i)]; }
 
-    // lectura de una posición del vector
-    double operator[](int i) const;
     // modificación de una posición del vector
-    double & operator[](int i);
+    constexpr T & operator[](int i) { return c[checked_index(i)]; }
+
+    // operadores de asignación compuesta (componentes uno a uno, el relleno incluido)
+    // suma de vectores
+    constexpr basic_vector & operator+=(basic_vector const & v) {
+      for (std::size_t i = 0; i < Storage; ++i) {
+        c[i] = c[i] + v.c[i];
+      }
+      return *this;
+    }
+
+    // resta de vectores
+    constexpr basic_vector & operator-=(basic_vector const & v) {
+      for (std::size_t i = 0; i < Storage; ++i) {
+        c[i] = c[i] - v.c[i];
+      }
+      return *this;
+    }
 
-    // operadores de asignación compuesta
-    // suma de vectores (componentes uno a uno)
-    vector & operator+=(vector const & v);
-    // resta de vectores (componentes uno a uno)
-    vector & operator-=(vector const & v);
     // producto por un escalar t
-    vector & operator*=(double t);
+    constexpr basic_vector & operator*=(T t) {
+      for (T & component : c) {
+        component *= t;
+      }
+      return *this;
+    }
+
     // división por un escalar t
-    vector & operator/=(double t);
+    constexpr basic_vector & operator/=(T t) { return *this *= (T{1} / t); }
 
     // MAGNITUDES
 
-    [[nodiscard]] double magnitude_squared() const;  // <-- DECLARACIÓN AÑADIDA
-    [[nodiscard]] double magnitude() const;
+    [[nodiscard]] constexpr T magnitude_squared() const {
+      return c[0] * c[0] + c[1] * c[1] + c[2] * c[2];
+    }
+
+    [[nodiscard]] constexpr T magnitude() const { return std::sqrt(magnitude_squared()); }
 
     // UTILIDAD NUMÉRICA (para estabilidad, Sección 3.5.1)
-    [[nodiscard]] bool near_zero() const {
-      auto const s = 1e-8;
-      return (std::abs(x) < s) and (std::abs(y) < s) and (std::abs(z) < s);
+    [[nodiscard]] constexpr bool near_zero() const {
+      auto const s = static_cast<T>(1e-8);
+      return (std::abs(c[0]) < s) and (std::abs(c[1]) < s) and (std::abs(c[2]) < s);
     }
 
-  private:
-    double x, y, z;
-  };
+    // f aplicada a cada componente guardado (el relleno incluido)
+    template <typename F>
+    static constexpr basic_vector map(basic_vector const & v, F f) {
+      basic_vector result;
+      for (std::size_t i = 0; i < Storage; ++i) {
+        result.c[i] = f(v.c[i]);
+      }
+      return result;
+    }
 
-  // DEFINICIÓN DE MAGNITUDES
+    template <typename F>
+    static constexpr basic_vector zip(basic_vector const & u, basic_vector const & v, F f) {
+      basic_vector result;
+      for (std::size_t i = 0; i < Storage; ++i) {
+        result.c[i] = f(u.c[i], v.c[i]);
+      }
+      return result;
+    }
 
-  inline double vector::magnitude_squared() const {
-    return x * x + y * y + z * z;
-  }
+    // con relleno, con los componentes rotados (y, z, x) y (z, x, y): dos productos y una resta
+    // de 4 carriles más permutaciones (el relleno queda 0 * 0 - 0 * 0)
+    static constexpr basic_vector cross(basic_vector const & u, basic_vector const & v) {
+      if constexpr (Storage == 4) {
+        constexpr std::array<std::size_t, 4> next{1, 2, 0, 3};
+        constexpr std::array<std::size_t, 4> prev{2, 0, 1, 3};
+        basic_vector result;
+        for (std::size_t i = 0; i < Storage; ++i) {
+          result.c[i] = u.c[next[i]] * v.c[prev[i]] - u.c[prev[i]] * v.c[next[i]];
+        }
+        return result;
+      } else {
+        return {u.c[1] * v.c[2] - u.c[2] * v.c[1], u.c[2] * v.c[0] - u.c[0] * v.c[2],
+                u.c[0] * v.c[1] - u.c[1] * v.c[0]};
+      }
+    }
 
-  inline double vector::magnitude() const {
-    return std::sqrt(magnitude_squared());
-  }
+  private:
+    // x, y o z; el relleno no es accesible por índice
+    static constexpr std::size_t checked_index(int i) {
+      if (i < 0 or i > 2) {
+        throw std::out_of_range("vector index out of range");
+      }
+      return static_cast<std::size_t>(i);
+    }
+
+    std::array<T, Storage> c{};
+  };
 
   // DECLARACIÓN de alias
 
+  // vector de doubles (el de todo el render salvo los buffers de rayos en modo RENDER_FLOAT)
+  using vector = basic_vector<double>;
   // para posición
   using point_vector = vector;
   // para color
@@ -88,60 +184,79 @@ namespace render {
   using normal_vector = vector;
 
   // UTILIDADES GLOBALES
-  // están definidas como inline para que se inserten directamente en la llamada. No cambian el
-  // valor como las de asignación compuesto
+  // están definidas como constexpr (implícitamente inline) para que se inserten directamente en
+  // la llamada. No cambian el valor como las de asignación compuesto. El escalar de los productos
+  // no participa en la deducción de T (type_identity_t): 2 * v o 0.5 * v valen para cualquier
+  // vector
 
   // imprime valores de un vector directamente al stream out separados por espacios
-  inline std::ostream & operator<<(std::ostream & out, vector const & v) {
+  template <typename T, std::size_t S>
+  std::ostream & operator<<(std::ostream & out, basic_vector<T, S> const & v) {
     return out << v.get_x() << ' ' << v.get_y() << ' ' << v.get_z();
   }
 
   // suma de dos vectores
-  inline vector operator+(vector const & u, vector const & v) {
-    return {u.get_x() + v.get_x(), u.get_y() + v.get_y(), u.get_z() + v.get_z()};
+  template <typename T, std::size_t S>
+  constexpr basic_vector<T, S> operator+(basic_vector<T, S> const & u,
+                                         basic_vector<T, S> const & v) {
+    return basic_vector<T, S>::zip(u, v, [](T a, T b) { return a + b; });
   }
 
   // resta de dos vectores
-  inline vector operator-(vector const & u, vector const & v) {
-    return {u.get_x() - v.get_x(), u.get_y() - v.get_y(), u.get_z() - v.get_z()};
+  template <typename T, std::size_t S>
+  constexpr basic_vector<T, S> operator-(basic_vector<T, S> const & u,
+                                         basic_vector<T, S> const & v) {
+    return basic_vector<T, S>::zip(u, v, [](T a, T b) { return a - b; });
   }
 
   // producto hadamard (elemento a elemento, usado para el color)
-  inline vector operator*(vector const & u, vector const & v) {
-    return {u.get_x() * v.get_x(), u.get_y() * v.get_y(), u.get_z() * v.get_z()};
+  template <typename T, std::size_t S>
+  constexpr basic_vector<T, S> operator*(basic_vector<T, S> const & u,
+                                         basic_vector<T, S> const & v) {
+    return basic_vector<T, S>::zip(u, v, [](T a, T b) { return a * b; });
   }
 
   // producto por un escalar t (primero t*v luego v*t)
-  inline vector operator*(double t, vector const & v) {
-    return {t * v.get_x(), t * v.get_y(), t * v.get_z()};
+  template <typename T, std::size_t S>
+  constexpr basic_vector<T, S> operator*(std::type_identity_t<T> t, basic_vector<T, S> const & v) {
+    return basic_vector<T, S>::map(v, [t](T a) { return t * a; });
   }
 
-  inline vector operator*(vector const & v, double t) {
+  template <typename T, std::size_t S>
+  constexpr basic_vector<T, S> operator*(basic_vector<T, S> const & v, std::type_identity_t<T> t) {
     return t * v;
   }
 
   // división por un escalar t
-  inline vector operator/(vector const & v, double t) {
+  template <typename T, std::size_t S>
+  constexpr basic_vector<T, S> operator/(basic_vector<T, S> const & v, std::type_identity_t<T> t) {
     return (1 / t) * v;
   }
 
   // dot product (multiplica cada posición del vector y suma)
-  inline double dot(vector const & u, vector const & v) {
+  template <typename T, std::size_t S>
+  constexpr T dot(basic_vector<T, S> const & u, basic_vector<T, S> const & v) {
     return u.get_x() * v.get_x() + u.get_y() * v.get_y() + u.get_z() * v.get_z();
   }
 
   // cross product (devuelve el vector perpendicular a los dados)
-  inline vector cross(vector const & u, vector const & v) {
-    return {u.get_y() * v.get_z() - u.get_z() * v.get_y(),
-            u.get_z() * v.get_x() - u.get_x() * v.get_z(),
-            u.get_x() * v.get_y() - u.get_y() * v.get_x()};
+  template <typename T, std::size_t S>
+  constexpr basic_vector<T, S> cross(basic_vector<T, S> const & u, basic_vector<T, S> const & v) {
+    return basic_vector<T, S>::cross(u, v);
   }
 
   // normalización
-  inline vector unit_vector(vector const & v) {
+  template <typename T, std::size_t S>
+  constexpr basic_vector<T, S> unit_vector(basic_vector<T, S> const & v) {
     return v / v.magnitude();
   }
 
+  // conversión entre escalares (los buffers en float del modo RENDER_FLOAT y el render en double)
+  template <typename U, typename T, std::size_t S>
+  constexpr basic_vector<U, S> vector_cast(basic_vector<T, S> const & v) {
+    return {static_cast<U>(v.get_x()), static_cast<U>(v.get_y()), static_cast<U>(v.get_z())};
+  }
+
 }  // namespace render
 
 #endif
@@ -0,0 +1,114 @@
+#include "../include/accumulation_buffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace render {
+
+  namespace {
+
+    // copia los bytes de cada valor en un bloque contiguo y lo escribe de una vez
+    template <typename T>
+    void write_values(std::ostream & out, std::vector<T> const & values) {
+      std::vector<char> bytes(values.size() * sizeof(T));
+      auto dst = bytes.begin();
+      for (T const value : values) {
+        auto raw = std::bit_cast<std::array<char, sizeof(T)>>(value);
+        dst      = std::ranges::copy(raw, dst).out;
+      }
+      out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    template <typename T>
+    bool read_values(std::istream & in, std::vector<T> & values) {
+      std::vector<char> bytes(values.size() * sizeof(T));
+      if (!in.read(bytes.data(), static_cast<std::streamsize>(bytes.size()))) {
+        return false;
+      }
+      std::array<char, sizeof(T)> raw{};
+      auto src = bytes.begin();
+      for (T & value : values) {
+        std::copy_n(src, sizeof(T), raw.begin());
+        src   += sizeof(T);
+        value  = std::bit_cast<T>(raw);
+      }
+      return true;
+    }
+
+  }  // namespace
+
+  AccumulationBuffer::AccumulationBuffer(int width, int height)
+      : width_(width), height_(height), sum_r_(total_pixels(), 0.0), sum_g_(total_pixels(), 0.0),
+        sum_b_(total_pixels(), 0.0), counts_(total_pixels(), 0) { }
+
+  void AccumulationBuffer::add_sample(int x, int y, color_vector const & color) {
+    add_samples(x, y, color, 1);
+  }
+
+  void AccumulationBuffer::add_samples(int x, int y, color_vector const & sum,
+                                       std::uint32_t count) {
+    std::size_t const idx  = index(x, y);
+    sum_r_[idx]           += sum.r();
+    sum_g_[idx]           += sum.g();
+    sum_b_[idx]           += sum.b();
+    counts_[idx]          += count;
+  }
+
+  // media de las muestras
+  // se multiplica por el inverso (igual que el bucle original de muestras por píxel) para que el
+  // resultado sea idéntico bit a bit
+  color_vector AccumulationBuffer::average(int x, int y) const {
+    std::size_t const idx = index(x, y);
+    if (counts_[idx] == 0) {
+      return {0.0, 0.0, 0.0};
+    }
+    double const scale = 1.0 / counts_[idx];
+    return {sum_r_[idx] * scale, sum_g_[idx] * scale, sum_b_[idx] * scale};
+  }
+
+  void AccumulationBuffer::row_average(int y, std::span<double> r, std::span<double> g,
+                                       std::span<double> b) const {
+    std::size_t const base = index(0, y);
+    for (std::size_t x = 0; x < static_cast<std::size_t>(width_); ++x) {
+      std::uint32_t const count = counts_[base + x];
+      double const scale        = count == 0 ? 0.0 : 1.0 / count;
+      r[x]                      = sum_r_[base + x] * scale;
+      g[x]                      = sum_g_[base + x] * scale;
+      b[x]                      = sum_b_[base + x] * scale;
+    }
+  }
+
+  std::uint64_t AccumulationBuffer::total_samples() const {
+    std::uint64_t total = 0;
+    for (std::uint32_t const count : counts_) {
+      total += count;
+    }
+    return total;
+  }
+
+  void AccumulationBuffer::write(std::ostream & out) const {
+    out << "buffer " << width_ << ' ' << height_ << '\n';
+    write_values(out, sum_r_);
+    write_values(out, sum_g_);
+    write_values(out, sum_b_);
+    write_values(out, counts_);
+  }
+
+  bool AccumulationBuffer::read(std::istream & in) {
+    std::string tag;
+    int width  = 0;
+    int height = 0;
+    if (!(in >> tag >> width >> height) or tag != "buffer" or width != width_ or
+        height != height_ or in.get() != '\n')
+    {
+      return false;
+    }
+    return read_values(in, sum_r_) and read_values(in, sum_g_) and read_values(in, sum_b_) and
+           read_values(in, counts_);
+  }
+
+}  // namespace render
@@ -0,0 +1,108 @@
+#include "../include/alloc_counter.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <ostream>
+
+namespace {
+
+  // inicialización constante y destructor trivial: operator new puede usarlo en cualquier
+  // momento de la vida del hilo sin provocar a su vez una asignación
+  constinit thread_local render::AllocationCount thread_counts{};
+
+}  // namespace
+
+#ifdef RENDER_ALLOC_COUNTING
+
+// Sustitución global de operator new/delete (las variantes nothrow, con tamaño y de arrays de la
+// biblioteca estándar llaman a estas). Las de alineación extendida no se sustituyen y siguen
+// emparejadas con las de la biblioteca
+void * operator new(std::size_t size) {
+  ++thread_counts.allocations;
+  thread_counts.bytes += size;
+  // malloc(0) puede devolver nullptr; operator new debe devolver un puntero único
+  if (void * ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+
+void operator delete(void * ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void * ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+#endif
+
+namespace render {
+
+  AllocationCount thread_allocations() {
+    return thread_counts;
+  }
+
+  void rewind_thread_allocations(AllocationCount const & mark) {
+    thread_counts = mark;
+  }
+
+  AllocationProfile & AllocationProfile::instance() {
+    static AllocationProfile profile;
+    return profile;
+  }
+
+  void AllocationProfile::add_phase(char const * name, char const * category,
+                                    AllocationCount const & delta) {
+    std::lock_guard const lock(mutex_);
+    auto it = std::ranges::find(phases_, std::string_view(name), &PhaseTotals::name);
+    if (it == phases_.end()) {
+      it = phases_.insert(phases_.end(),
+                          PhaseTotals{.name = name, .category = category, .calls = 0, .count = {}});
+    }
+    ++it->calls;
+    it->count.allocations += delta.allocations;
+    it->count.bytes       += delta.bytes;
+  }
+
+  AllocationCount AllocationProfile::category_total(std::string_view category) const {
+    std::lock_guard const lock(mutex_);
+    AllocationCount total;
+    for (PhaseTotals const & phase : phases_) {
+      if (phase.category == category) {
+        total.allocations += phase.count.allocations;
+        total.bytes       += phase.count.bytes;
+      }
+    }
+    return total;
+  }
+
+  void AllocationProfile::write_report(std::ostream & out) const {
+    std::lock_guard const lock(mutex_);
+    // "categoría" ocupa 10 bytes en UTF-8 para 9 columnas, como las filas
+    out << "Asignaciones de memoria por fase:\n"
+        << std::left << std::setw(24) << "fase" << std::setw(10) << "categoría" << std::right
+        << std::setw(10) << "llamadas" << std::setw(14) << "asignaciones" << std::setw(14)
+        << "bytes" << '\n';
+    for (PhaseTotals const & phase : phases_) {
+      out << std::left << std::setw(24) << phase.name << std::setw(9) << phase.category
+          << std::right << std::setw(10) << phase.calls << std::setw(14)
+          << phase.count.allocations << std::setw(14) << phase.count.bytes << '\n';
+    }
+  }
+
+}  // namespace render
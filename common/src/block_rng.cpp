@@ -0,0 +1,152 @@
+#include "../include/block_rng.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
+namespace render {
+
+  namespace {
+
+    // estado de un carril
+    using Lane = std::array<std::uint64_t, 4>;
+
+    // salto de 2^128 pasos (constantes de Blackman y Vigna)
+    constexpr Lane JUMP{0x180e'c6d3'3cfd'0abaULL, 0xd5a6'1266'f0c9'392cULL,
+                        0xa958'2618'e03f'c9aaULL, 0x39ab'dc45'29b1'661cULL};
+
+    constexpr std::uint64_t splitmix64(std::uint64_t & x) {
+      x                += 0x9e37'79b9'7f4a'7c15ULL;
+      std::uint64_t z  = x;
+      z                = (z ^ (z >> 30U)) * 0xbf58'476d'1ce4'e5b9ULL;
+      z                = (z ^ (z >> 27U)) * 0x94d0'49bb'1331'11ebULL;
+      return z ^ (z >> 31U);
+    }
+
+    // avance de un paso de xoshiro256+ sin salida
+    constexpr void step(Lane & s) {
+      std::uint64_t const t  = s[1] << 17U;
+      s[2]                  ^= s[0];
+      s[3]                  ^= s[1];
+      s[1]                  ^= s[2];
+      s[0]                  ^= s[3];
+      s[2]                  ^= t;
+      s[3]                   = std::rotl(s[3], 45);
+    }
+
+    constexpr void jump_lane(Lane & s) {
+      Lane acc{};
+      for (std::uint64_t const word : JUMP) {
+        for (unsigned bit = 0; bit < 64; ++bit) {
+          if ((word & (std::uint64_t{1} << bit)) != 0) {
+            for (std::size_t w = 0; w < acc.size(); ++w) {
+              acc[w] ^= s[w];
+            }
+          }
+          step(s);
+        }
+      }
+      s = acc;
+    }
+
+    // 52 bits altos como mantisa de [1, 2) menos 1 (23 para float)
+    template <typename T>
+    T to_unit(std::uint64_t bits) {
+      if constexpr (std::is_same_v<T, double>) {
+        return std::bit_cast<double>((bits >> 12U) | 0x3ff0'0000'0000'0000ULL) - 1.0;
+      } else {
+        return std::bit_cast<float>(static_cast<std::uint32_t>(bits >> 41U) | 0x3f80'0000U) -
+               1.0F;
+      }
+    }
+
+    template <typename T, typename Next>
+    void fill_lanes(std::span<T> out, Next next) {
+      constexpr std::size_t lanes = BlockRNG::LANES;
+      for (std::size_t i = 0; i < out.size(); i += lanes) {
+        std::array<std::uint64_t, lanes> const bits = next();
+        std::size_t const count                     = std::min(lanes, out.size() - i);
+        for (std::size_t l = 0; l < count; ++l) {
+          out[i + l] = to_unit<T>(bits[l]);
+        }
+      }
+    }
+
+  }  // namespace
+
+  BlockRNG::BlockRNG(std::uint64_t seed) {
+    Lane lane{};
+    for (std::uint64_t & word : lane) {
+      word = splitmix64(seed);
+    }
+    for (std::size_t l = 0; l < LANES; ++l) {
+      for (std::size_t w = 0; w < lane.size(); ++w) {
+        state_[w][l] = lane[w];
+      }
+      jump_lane(lane);
+    }
+  }
+
+  void BlockRNG::jump() {
+    for (std::size_t l = 0; l < LANES; ++l) {
+      Lane lane{state_[0][l], state_[1][l], state_[2][l], state_[3][l]};
+      for (std::size_t j = 0; j < LANES; ++j) {
+        jump_lane(lane);
+      }
+      for (std::size_t w = 0; w < lane.size(); ++w) {
+        state_[w][l] = lane[w];
+      }
+    }
+  }
+
+  // el paso de step() con cada palabra del estado como un vector de LANES carriles
+  std::array<std::uint64_t, BlockRNG::LANES> BlockRNG::next() {
+    auto & [s0, s1, s2, s3] = state_;
+    std::array<std::uint64_t, LANES> result{};
+    for (std::size_t l = 0; l < LANES; ++l) {
+      result[l]              = s0[l] + s3[l];
+      std::uint64_t const t  = s1[l] << 17U;
+      s2[l]                 ^= s0[l];
+      s3[l]                 ^= s1[l];
+      s1[l]                 ^= s2[l];
+      s0[l]                 ^= s3[l];
+      s2[l]                 ^= t;
+      s3[l]                  = std::rotl(s3[l], 45);
+    }
+    return result;
+  }
+
+  void BlockRNG::fill(std::span<double> out) {
+    fill_lanes(out, [this] { return next(); });
+  }
+
+  void BlockRNG::fill(std::span<float> out) {
+    fill_lanes(out, [this] { return next(); });
+  }
+
+  void BlockRNG::save_state(std::ostream & out) const {
+    char const * separator = "";
+    for (auto const & word : state_) {
+      for (std::uint64_t const value : word) {
+        out << separator << value;
+        separator = " ";
+      }
+    }
+  }
+
+  bool BlockRNG::load_state(std::istream & in) {
+    std::array<std::array<std::uint64_t, LANES>, 4> restored{};
+    for (auto & word : restored) {
+      for (std::uint64_t & value : word) {
+        if (!(in >> value)) {
+          return false;
+        }
+      }
+    }
+    state_ = restored;
+    return true;
+  }
+
+}  // namespace render
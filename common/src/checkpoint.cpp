@@ -0,0 +1,104 @@
+#include "../include/checkpoint.hpp"
+#include "../include/config_parser.hpp"
+#include "../include/trace.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace render {
+
+  namespace {
+
+    // cabecera del fichero, se incrementa la versión si cambia el formato
+    constexpr char const * CHECKPOINT_MAGIC = "render-checkpoint";
+    constexpr int CHECKPOINT_VERSION        = 1;
+
+    // la configuración se guarda en el formato de texto del parser entre dos marcas
+    bool read_config_section(std::istream & in, ConfigParams & config) {
+      std::string line;
+      if (!std::getline(in, line) or line != "config") {
+        return false;
+      }
+      std::string text;
+      while (std::getline(in, line) and line != "end_config") {
+        text += line;
+        text += '\n';
+      }
+      std::istringstream config_text(text);
+      return line == "end_config" and parse_config(config_text, config);
+    }
+
+    bool read_rng(std::istream & in, RNG & rng) {
+      std::string tag;
+      return (in >> tag) and tag == "rng" and rng.load_state(in) and in.get() == '\n';
+    }
+
+  }  // namespace
+
+  bool save_checkpoint(std::string const & filename, CheckpointData const & data) {
+    ScopedTimer const timer("save_checkpoint", "io");
+    std::string const tmp_filename = filename + ".tmp";
+    {
+      std::ofstream out(tmp_filename, std::ios::binary | std::ios::trunc);
+      if (!out.is_open()) {
+        std::cerr << "Error: Cannot create checkpoint file " << tmp_filename << '\n';
+        return false;
+      }
+      out << CHECKPOINT_MAGIC << ' ' << CHECKPOINT_VERSION << '\n' << "config\n";
+      write_config(out, *data.config);
+      out << "end_config\n" << "progress " << data.progress << '\n' << "rng ";
+      data.ray_rng->save_state(out);
+      out << '\n' << "rng ";
+      data.material_rng->save_state(out);
+      out << '\n';
+      data.buffer->write(out);
+      if (!out.flush()) {
+        std::cerr << "Error: Cannot write checkpoint file " << tmp_filename << '\n';
+        return false;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_filename, filename, ec);
+    if (ec) {
+      std::cerr << "Error: Cannot replace checkpoint file " << filename << ": " << ec.message()
+                << '\n';
+      return false;
+    }
+    return true;
+  }
+
+  bool load_checkpoint(std::string const & filename, CheckpointData & data) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) {
+      std::cerr << "Error: Cannot open checkpoint file " << filename << '\n';
+      return false;
+    }
+    std::string magic;
+    int version = 0;
+    if (!(in >> magic >> version) or magic != CHECKPOINT_MAGIC or version != CHECKPOINT_VERSION or
+        in.get() != '\n')
+    {
+      std::cerr << "Error: Invalid checkpoint header in " << filename << '\n';
+      return false;
+    }
+    ConfigParams saved_config;
+    if (!read_config_section(in, saved_config) or !(saved_config == *data.config)) {
+      std::cerr << "Error: Checkpoint " << filename << " was created with a different configuration"
+                << '\n';
+      return false;
+    }
+    std::string tag;
+    if (!(in >> tag >> data.progress) or tag != "progress" or in.get() != '\n' or
+        !read_rng(in, *data.ray_rng) or !read_rng(in, *data.material_rng) or
+        !data.buffer->read(in))
+    {
+      std::cerr << "Error: Corrupted checkpoint file " << filename << '\n';
+      return false;
+    }
+    return true;
+  }
+
+}  // namespace render
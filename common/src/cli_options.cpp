@@ -0,0 +1,310 @@
+#include "../include/cli_options.hpp"
+#include "../include/alloc_counter.hpp"
+#include "../include/render_stats.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+  // Cada opción recibe el índice de su nombre en args y avanza el índice si consume un valor
+  using OptionHandler =
+      std::function<bool(RenderOptions &, std::vector<std::string> const &, std::size_t &)>;
+
+  bool next_value(std::vector<std::string> const & args, std::size_t & idx, std::string & value) {
+    if (idx + 1 >= args.size()) {
+      std::cerr << "Missing value for option " << args[idx] << '\n';
+      return false;
+    }
+    value = args[++idx];
+    return true;
+  }
+
+  bool next_double(std::vector<std::string> const & args, std::size_t & idx, double & value) {
+    std::string text;
+    if (!next_value(args, idx, text)) {
+      return false;
+    }
+    try {
+      std::size_t used = 0;
+      value            = std::stod(text, &used);
+      if (used == text.size()) {
+        return true;
+      }
+    } catch (...) {
+      // se informa abajo
+    }
+    std::cerr << "Invalid value for option " << args[idx - 1] << ": " << text << '\n';
+    return false;
+  }
+
+  bool next_positive_int(std::vector<std::string> const & args, std::size_t & idx, int & value) {
+    std::string text;
+    if (!next_value(args, idx, text)) {
+      return false;
+    }
+    try {
+      std::size_t used = 0;
+      value            = std::stoi(text, &used);
+      if (used == text.size() and value > 0) {
+        return true;
+      }
+    } catch (...) {
+      // se informa abajo
+    }
+    std::cerr << "Invalid value for option " << args[idx - 1] << ": " << text
+              << " (must be a positive integer)\n";
+    return false;
+  }
+
+  bool handle_backend(RenderOptions & options, std::vector<std::string> const & args,
+                      std::size_t & idx) {
+    std::string backend;
+    if (!next_value(args, idx, backend)) {
+      return false;
+    }
+    if (backend != "aos" and backend != "soa") {
+      std::cerr << "Invalid value for option --backend: " << backend << " (must be aos or soa)\n";
+      return false;
+    }
+    options.backend = backend == "aos" ? Backend::AOS : Backend::SOA;
+    return true;
+  }
+
+  bool handle_resume(RenderOptions & options, std::vector<std::string> const &, std::size_t &) {
+    options.resume = true;
+    return true;
+  }
+
+  bool handle_checkpoint(RenderOptions & options, std::vector<std::string> const & args,
+                         std::size_t & idx) {
+    return next_value(args, idx, options.checkpoint_file);
+  }
+
+  bool handle_checkpoint_interval(RenderOptions & options, std::vector<std::string> const & args,
+                                  std::size_t & idx) {
+    if (!next_double(args, idx, options.checkpoint_interval)) {
+      return false;
+    }
+    if (options.checkpoint_interval < 0) {
+      std::cerr << "Invalid value for option --checkpoint-interval: must be >= 0\n";
+      return false;
+    }
+    return true;
+  }
+
+  bool handle_time_budget(RenderOptions & options, std::vector<std::string> const & args,
+                          std::size_t & idx) {
+    if (!next_double(args, idx, options.time_budget)) {
+      return false;
+    }
+    if (options.time_budget <= 0) {
+      std::cerr << "Invalid value for option --time-budget: must be > 0\n";
+      return false;
+    }
+    return true;
+  }
+
+  bool handle_progressive(RenderOptions & options, std::vector<std::string> const &,
+                          std::size_t &) {
+    options.progressive = true;
+    return true;
+  }
+
+  bool handle_pass_samples(RenderOptions & options, std::vector<std::string> const & args,
+                           std::size_t & idx) {
+    return next_positive_int(args, idx, options.pass_samples);
+  }
+
+  bool handle_snapshot(RenderOptions & options, std::vector<std::string> const & args,
+                       std::size_t & idx) {
+    return next_value(args, idx, options.snapshot_file);
+  }
+
+  bool handle_snapshot_every(RenderOptions & options, std::vector<std::string> const & args,
+                             std::size_t & idx) {
+    return next_positive_int(args, idx, options.snapshot_every);
+  }
+
+  bool handle_snapshot_interval(RenderOptions & options, std::vector<std::string> const & args,
+                                std::size_t & idx) {
+    if (!next_double(args, idx, options.snapshot_interval)) {
+      return false;
+    }
+    if (options.snapshot_interval < 0) {
+      std::cerr << "Invalid value for option --snapshot-interval: must be >= 0\n";
+      return false;
+    }
+    return true;
+  }
+
+  bool handle_stats(RenderOptions & options, std::vector<std::string> const &, std::size_t &) {
+    options.stats = true;
+    return true;
+  }
+
+  bool handle_stats_json(RenderOptions & options, std::vector<std::string> const &,
+                         std::size_t &) {
+    options.stats      = true;
+    options.stats_json = true;
+    return true;
+  }
+
+  bool handle_perf(RenderOptions & options, std::vector<std::string> const &, std::size_t &) {
+    options.perf = true;
+    return true;
+  }
+
+  bool handle_heatmap(RenderOptions & options, std::vector<std::string> const & args,
+                      std::size_t & idx) {
+    return next_value(args, idx, options.heatmap_file);
+  }
+
+  bool handle_heatmap_metric(RenderOptions & options, std::vector<std::string> const & args,
+                             std::size_t & idx) {
+    std::string metric;
+    if (!next_value(args, idx, metric)) {
+      return false;
+    }
+    if (metric != "tests" and metric != "time") {
+      std::cerr << "Invalid value for option --heatmap-metric: " << metric
+                << " (must be tests or time)\n";
+      return false;
+    }
+    options.heatmap_time = metric == "time";
+    return true;
+  }
+
+  bool handle_object_profile(RenderOptions & options, std::vector<std::string> const & args,
+                             std::size_t & idx) {
+    return next_positive_int(args, idx, options.object_profile);
+  }
+
+  bool handle_alloc_stats(RenderOptions & options, std::vector<std::string> const &,
+                          std::size_t &) {
+    options.alloc_stats = true;
+    return true;
+  }
+
+  bool handle_quiet(RenderOptions & options, std::vector<std::string> const &, std::size_t &) {
+    options.quiet = true;
+    return true;
+  }
+
+  bool handle_trace(RenderOptions & options, std::vector<std::string> const & args,
+                    std::size_t & idx) {
+    return next_value(args, idx, options.trace_file);
+  }
+
+  std::unordered_map<std::string, OptionHandler> const & get_option_handlers() {
+    static std::unordered_map<std::string, OptionHandler> const handlers = {
+      {            "--backend",             handle_backend},
+      {             "--resume",              handle_resume},
+      {         "--checkpoint",          handle_checkpoint},
+      {"--checkpoint-interval", handle_checkpoint_interval},
+      {        "--time-budget",         handle_time_budget},
+      {        "--progressive",         handle_progressive},
+      {       "--pass-samples",        handle_pass_samples},
+      {           "--snapshot",            handle_snapshot},
+      {     "--snapshot-every",      handle_snapshot_every},
+      {  "--snapshot-interval",   handle_snapshot_interval},
+      {              "--stats",               handle_stats},
+      {         "--stats-json",          handle_stats_json},
+      {              "--trace",               handle_trace},
+      {               "--perf",                handle_perf},
+      {            "--heatmap",             handle_heatmap},
+      {     "--heatmap-metric",      handle_heatmap_metric},
+      {     "--object-profile",      handle_object_profile},
+      {        "--alloc-stats",         handle_alloc_stats},
+      {              "--quiet",               handle_quiet},
+    };
+    return handlers;
+  }
+
+  // opciones válidas por separado que no se pueden usar juntas
+  bool check_combinations(RenderOptions const & options) {
+    if (options.resume and options.time_budget > 0) {
+      std::cerr << "Options --resume and --time-budget cannot be combined\n";
+      return false;
+    }
+    if (options.resume and options.progressive) {
+      std::cerr << "Options --resume and --progressive cannot be combined\n";
+      return false;
+    }
+    if (!options.heatmap_file.empty() and !options.heatmap_time and !render::stats_enabled()) {
+      std::cerr << "Option --heatmap needs --heatmap-metric time when built with "
+                   "ENABLE_RENDER_STATS=OFF\n";
+      return false;
+    }
+    if (options.object_profile > 0 and !render::stats_enabled()) {
+      std::cerr << "Option --object-profile is not available with ENABLE_RENDER_STATS=OFF\n";
+      return false;
+    }
+    if (options.alloc_stats and !render::allocation_counting_enabled()) {
+      std::cerr << "Option --alloc-stats is not available with ENABLE_ALLOC_COUNTING=OFF\n";
+      return false;
+    }
+    return true;
+  }
+
+}  // namespace
+
+bool parse_options(std::vector<std::string> const & args, RenderOptions & options) {
+  std::vector<std::string> positional;
+  auto const & handlers = get_option_handlers();
+  for (std::size_t idx = 1; idx < args.size(); ++idx) {
+    std::string const & arg = args[idx];
+    if (!arg.starts_with("--")) {
+      positional.push_back(arg);
+      continue;
+    }
+    auto it = handlers.find(arg);
+    if (it == handlers.end()) {
+      std::cerr << "Unknown option: " << arg << '\n';
+      return false;
+    }
+    if (!it->second(options, args, idx)) {
+      return false;
+    }
+  }
+  if (positional.size() != 3) {
+    std::cerr << "Expected 3 positional arguments, got " << positional.size() << '\n';
+    return false;
+  }
+  if (!check_combinations(options)) {
+    return false;
+  }
+  options.config_file = positional[0];
+  options.scene_file  = positional[1];
+  options.output_file = positional[2];
+  return true;
+}
+
+std::string usage(std::string const & program) {
+  return "Uso: " + program +
+         " <config_file.cfg> <scene_file.txt> <output_file.ppm> [opciones]\n"
+         "Opciones:\n"
+         "  --backend <aos|soa>            trazador AOS (rayo a rayo) o SOA (por olas)\n"
+         "  --checkpoint <file>            fichero de checkpoint (por defecto <output>.ckpt)\n"
+         "  --checkpoint-interval <s>      segundos entre checkpoints (0 = desactivados)\n"
+         "  --resume                       continúa desde el último checkpoint\n"
+         "  --time-budget <s>              pasadas progresivas hasta agotar <s> segundos\n"
+         "  --progressive                  render por pasadas con imágenes intermedias\n"
+         "  --pass-samples <n>             muestras por píxel en cada pasada (por defecto 1)\n"
+         "  --snapshot <file>              imagen intermedia (por defecto <output>.snapshot.ppm)\n"
+         "  --snapshot-every <n>           imagen intermedia cada <n> pasadas\n"
+         "  --snapshot-interval <s>        imagen intermedia cada <s> segundos (0 = nunca)\n"
+         "  --stats                        contadores de rayos al terminar (texto)\n"
+         "  --stats-json                   contadores de rayos al terminar (JSON)\n"
+         "  --trace <file.json>            duración de cada fase (formato Chrome trace_event)\n"
+         "  --perf                         IPC y fallos de caché por rayo en cada fase (Linux)\n"
+         "  --heatmap <file.ppm>           mapa de coste por píxel con rampa de color\n"
+         "  --heatmap-metric <tests|time>  coste = pruebas rayo-objeto (defecto) o tiempo\n"
+         "  --object-profile <n>           los <n> objetos con más pruebas de intersección\n"
+         "  --alloc-stats                  asignaciones por fase; error si el render asigna\n"
+         "  --quiet                        sin indicador de progreso\n";
+}
@@ -1,9 +1,12 @@
 #include "../include/config_parser.hpp"
 #include "../include/parser_utilities.hpp"
+#include "../include/sampler.hpp"
+#include "../include/trace.hpp"
 
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -335,6 +338,93 @@ namespace {
     return true;
   }
 
+  bool handle_adaptivesampling(ConfigParams & config, std::vector<std::string> const & tokens,
+                               std::string const & line) {
+    if (tokens.size() < 4) {
+      std::cerr << "Invalid value for key adaptivesampling\nLine: " << line << '\n';
+      return false;
+    }
+    if (!check_excess_tokens(tokens, 4, "adaptivesampling")) {
+      return false;
+    }
+    int min_samples{};
+    int max_samples{};
+    double threshold{};
+    if (!try_parse_int(tokens, 1, min_samples) or
+        !try_parse_int(tokens, 2, max_samples) or
+        !try_parse_double(tokens, 3, threshold))
+    {
+      std::cerr << "Invalid value for key adaptivesampling\nLine: " << line << '\n';
+      return false;
+    }
+    if (min_samples < 2 or max_samples < min_samples or threshold <= 0) {
+      std::cerr << "Invalid value for key adaptivesampling\nLine: " << line << '\n';
+      return false;
+    }
+    config.adaptive_min_samples = min_samples;
+    config.adaptive_max_samples = max_samples;
+    config.adaptive_threshold   = threshold;
+    return true;
+  }
+
+  bool handle_sampler(ConfigParams & config, std::vector<std::string> const & tokens,
+                      std::string const & line) {
+    if (tokens.size() < 2) {
+      std::cerr << "Invalid value for key sampler\nLine: " << line << '\n';
+      return false;
+    }
+    if (!check_excess_tokens(tokens, 2, "sampler")) {
+      return false;
+    }
+    auto const type = render::parse_sampler_type(tokens[1]);
+    if (!type) {
+      std::cerr << "Invalid value for key sampler\nLine: " << line << '\n';
+      return false;
+    }
+    config.sampler = *type;
+    return true;
+  }
+
+  bool handle_mattescatter(ConfigParams & config, std::vector<std::string> const & tokens,
+                           std::string const & line) {
+    if (tokens.size() < 2) {
+      std::cerr << "Invalid value for key mattescatter\nLine: " << line << '\n';
+      return false;
+    }
+    if (!check_excess_tokens(tokens, 2, "mattescatter")) {
+      return false;
+    }
+    if (tokens[1] == "cube") {
+      config.matte_scatter = MatteScatter::CUBE;
+    } else if (tokens[1] == "cosine") {
+      config.matte_scatter = MatteScatter::COSINE;
+    } else {
+      std::cerr << "Invalid value for key mattescatter\nLine: " << line << '\n';
+      return false;
+    }
+    return true;
+  }
+
+  bool handle_rng(ConfigParams & config, std::vector<std::string> const & tokens,
+                  std::string const & line) {
+    if (tokens.size() < 2) {
+      std::cerr << "Invalid value for key rng\nLine: " << line << '\n';
+      return false;
+    }
+    if (!check_excess_tokens(tokens, 2, "rng")) {
+      return false;
+    }
+    if (tokens[1] == "mt19937") {
+      config.rng_engine = RngEngine::MT19937;
+    } else if (tokens[1] == "xoshiro") {
+      config.rng_engine = RngEngine::XOSHIRO;
+    } else {
+      std::cerr << "Invalid value for key rng\nLine: " << line << '\n';
+      return false;
+    }
+    return true;
+  }
+
   // Handlers map (file-local)
   std::unordered_map<std::string, Handler> const & get_handlers() {
     static std::unordered_map<std::string, Handler> const handlers = {
@@ -351,6 +441,10 @@ namespace {
       {          "rayrngseed",           handle_rayrngseed},
       { "backgrounddarkcolor",  handle_backgrounddarkcolor},
       {"backgroundlightcolor", handle_backgroundlightcolor},
+      {    "adaptivesampling",     handle_adaptivesampling},
+      {             "sampler",              handle_sampler},
+      {        "mattescatter",         handle_mattescatter},
+      {                 "rng",                  handle_rng},
     };
     return handlers;
   }
@@ -377,15 +471,9 @@ namespace {
   }
 
   // Internal implementation with internal linkage
-  bool parse_config_impl(std::string const & filename, ConfigParams & config) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-      std::cerr << "Cannot open config file: " << filename << '\n';
-      return false;
-    }
-
+  bool parse_config_impl(std::istream & input, ConfigParams & config) {
     std::string line;
-    while (std::getline(file, line)) {
+    while (std::getline(input, line)) {
       if (is_empty_line(line)) {
         continue;
       }
@@ -409,5 +497,51 @@ namespace {
 
 // Public entrypoint (declared in header)
 bool parse_config(std::string const & filename, ConfigParams & config_params) {
-  return parse_config_impl(filename, config_params);
+  render::ScopedTimer const timer("parse_config", "setup");
+  std::ifstream file(filename);
+  if (!file.is_open()) {
+    std::cerr << "Cannot open config file: " << filename << '\n';
+    return false;
+  }
+  return parse_config_impl(file, config_params);
+}
+
+bool parse_config(std::istream & input, ConfigParams & config_params) {
+  return parse_config_impl(input, config_params);
+}
+
+// Serialization with full double precision so that parse_config(write_config(c)) == c
+void write_config(std::ostream & output, ConfigParams const & c) {
+  auto const flags     = output.flags();
+  auto const precision = output.precision(std::numeric_limits<double>::max_digits10);
+  output << "aspect_ratio: " << c.aspect_width << ' ' << c.aspect_height << '\n'
+         << "imagewidth: " << c.image_width << '\n'
+         << "gamma: " << c.gamma << '\n'
+         << "cameraposition: " << c.camera_x << ' ' << c.camera_y << ' ' << c.camera_z << '\n'
+         << "cameratarget: " << c.target_x << ' ' << c.target_y << ' ' << c.target_z << '\n'
+         << "cameranorth: " << c.north_x << ' ' << c.north_y << ' ' << c.north_z << '\n'
+         << "fieldofview: " << c.field_of_view << '\n'
+         << "samplesperpixel: " << c.samples_per_pixel << '\n'
+         << "maxdepth: " << c.max_depth << '\n'
+         << "materialrngseed: " << c.material_rng_seed << '\n'
+         << "rayrngseed: " << c.ray_rng_seed << '\n'
+         << "backgrounddarkcolor: " << c.background_dark_color_r << ' '
+         << c.background_dark_color_g << ' ' << c.background_dark_color_b << '\n'
+         << "backgroundlightcolor: " << c.background_light_color_r << ' '
+         << c.background_light_color_g << ' ' << c.background_light_color_b << '\n';
+  if (c.adaptive_sampling()) {
+    output << "adaptivesampling: " << c.adaptive_min_samples << ' ' << c.adaptive_max_samples
+           << ' ' << c.adaptive_threshold << '\n';
+  }
+  if (c.sampler != SamplerType::RANDOM) {
+    output << "sampler: " << render::sampler_name(c.sampler) << '\n';
+  }
+  if (c.matte_scatter == MatteScatter::COSINE) {
+    output << "mattescatter: cosine\n";
+  }
+  if (c.rng_engine == RngEngine::XOSHIRO) {
+    output << "rng: xoshiro\n";
+  }
+  output.precision(precision);
+  output.flags(flags);
 }
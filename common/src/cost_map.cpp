@@ -0,0 +1,70 @@
+#include "../include/cost_map.hpp"
+#include "../include/trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace render {
+
+  namespace {
+
+    // puntos de la rampa, equiespaciados en [0, 1]
+    constexpr std::array<std::array<double, 3>, 5> RAMP_STOPS{
+      {{0.0, 0.0, 0.0},
+       {96.0, 0.0, 160.0},
+       {224.0, 48.0, 48.0},
+       {255.0, 200.0, 0.0},
+       {255.0, 255.0, 255.0}}
+    };
+
+  }  // namespace
+
+  CostMap::CostMap(int width, int height, Metric metric)
+      : width_(width), height_(height), metric_(metric),
+        cost_(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), 0) { }
+
+  std::uint64_t CostMap::max_cost() const {
+    return cost_.empty() ? 0 : std::ranges::max(cost_);
+  }
+
+  std::array<std::uint8_t, 3> CostMap::ramp(double t) {
+    double const segments = static_cast<double>(RAMP_STOPS.size() - 1);
+    double const scaled   = std::clamp(t, 0.0, 1.0) * segments;
+    auto const low        = std::min(static_cast<std::size_t>(scaled), RAMP_STOPS.size() - 2);
+    double const frac     = scaled - static_cast<double>(low);
+    std::array<std::uint8_t, 3> rgb{};
+    for (std::size_t c = 0; c < rgb.size(); ++c) {
+      double const value = std::lerp(RAMP_STOPS[low][c], RAMP_STOPS[low + 1][c], frac);
+      rgb[c]             = static_cast<std::uint8_t>(std::lround(value));
+    }
+    return rgb;
+  }
+
+  bool CostMap::write_ppm(std::string const & filename, bool last_row_first) const {
+    ScopedTimer const timer("write_heatmap", "io");
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.is_open()) {
+      std::cerr << "Error: Cannot create heatmap file " << filename << '\n';
+      return false;
+    }
+    out << "P6\n" << width_ << ' ' << height_ << "\n255\n";
+    double const scale = max_cost() > 0 ? 1.0 / static_cast<double>(max_cost()) : 0.0;
+    for (int row = 0; row < height_; ++row) {
+      int const y = last_row_first ? height_ - 1 - row : row;
+      for (int x = 0; x < width_; ++x) {
+        auto const rgb = ramp(static_cast<double>(at(x, y)) * scale);
+        out.put(static_cast<char>(rgb[0]));
+        out.put(static_cast<char>(rgb[1]));
+        out.put(static_cast<char>(rgb[2]));
+      }
+    }
+    if (!out) {
+      std::cerr << "Error: Cannot write heatmap file " << filename << '\n';
+      return false;
+    }
+    return true;
+  }
+
+}  // namespace render
@@ -2,6 +2,7 @@
 #include "../include/hit_record.hpp"
 #include "../include/objects.hpp"
 #include "../include/ray.hpp"
+#include "../include/render_stats.hpp"
 #include "../include/vector.hpp"
 
 #include <algorithm>
@@ -10,23 +11,35 @@
 
 namespace render {
 
+  namespace {
+
+    // vector de componentes T con las coordenadas de un objeto (guardadas en double)
+    template <typename T>
+    basic_vector<T> object_vector(double x, double y, double z) {
+      return {static_cast<T>(x), static_cast<T>(y), static_cast<T>(z)};
+    }
+
+  }  // namespace
+
   // ESFERA
 
   // colisión con una esfera
   // calcula el valor de 't' más cercano dentro del rango [t_min, t_max] donde el rayo 'r'
   // intersecta 'sph'. Devuelve -1.0 si no hay intersección válida
-  double hit_sphere(ray const & r, double t_min, double t_max, Sphere const * sph) {
-    point_vector center_vec(sph->center_x, sph->center_y, sph->center_z);
-    direction_vector oc = r.orig - center_vec;
-    auto a              = r.dir.magnitude();
-    auto half_b         = dot(oc, r.dir);
-    auto c              = oc.magnitude() - sph->radius * sph->radius;
-    auto discriminant   = half_b * half_b - a * c;
+  template <typename T>
+  T hit_sphere(basic_ray<T> const & r, T t_min, T t_max, Sphere const * sph) {
+    auto center_vec   = object_vector<T>(sph->center_x, sph->center_y, sph->center_z);
+    auto oc           = r.orig - center_vec;
+    auto a            = r.dir.magnitude_squared();
+    auto half_b       = dot(oc, r.dir);
+    auto radius       = static_cast<T>(sph->radius);
+    auto c            = oc.magnitude_squared() - radius * radius;
+    auto discriminant = half_b * half_b - a * c;
     if (discriminant < 0) {
-      return -1.0;
+      return T{-1};
     }
     auto sqrtd        = std::sqrt(discriminant);
-    double closest_t  = t_max;
+    T closest_t       = t_max;
     bool hit_anything = false;
     auto root1        = (-half_b - sqrtd) / a;
     if (root1 > t_min and root1 < closest_t) {
@@ -39,7 +52,7 @@ namespace render {
       hit_anything = true;
     }
     if (!hit_anything) {
-      return -1.0;
+      return T{-1};
     }
     return closest_t;
   }
@@ -64,24 +77,25 @@ namespace render {
   // colisión con un cilindro lateral
   // prueba intersecciones con la superficie lateral del cilindro y devuelve el 't' más cercano en
   // (t_min, t_max) o -1.0 si no hay hit lateral
-  double hit_cylinder_lateral(ray const & r, double t_min, double t_max, Cylinder const * cyl) {
-    point_vector center(cyl->center_x, cyl->center_y, cyl->center_z);
-    direction_vector axis = unit_vector(direction_vector(cyl->axis_x, cyl->axis_y, cyl->axis_z));
-    double radius = cyl->radius, HALF_HEIGHT = cyl->height / 2.0;
-    direction_vector oc = r.orig - center;
-    double a_dot_d = dot(axis, r.dir), a_dot_oc = dot(axis, oc);
-    auto A            = r.dir.magnitude() - a_dot_d * a_dot_d;
-    auto B            = 2.0 * (dot(r.dir, oc) - a_dot_d * a_dot_oc);
-    auto C            = oc.magnitude() - a_dot_oc * a_dot_oc - radius * radius;
-    auto discriminant = B * B - 4.0 * A * C;
-    double closest_t  = -1.0;
+  template <typename T>
+  T hit_cylinder_lateral(basic_ray<T> const & r, T t_min, T t_max, Cylinder const * cyl) {
+    auto center = object_vector<T>(cyl->center_x, cyl->center_y, cyl->center_z);
+    auto axis   = unit_vector(object_vector<T>(cyl->axis_x, cyl->axis_y, cyl->axis_z));
+    auto radius = static_cast<T>(cyl->radius), HALF_HEIGHT = static_cast<T>(cyl->height / 2.0);
+    auto oc = r.orig - center;
+    T a_dot_d = dot(axis, r.dir), a_dot_oc = dot(axis, oc);
+    auto A            = r.dir.magnitude_squared() - a_dot_d * a_dot_d;
+    auto B            = T{2} * (dot(r.dir, oc) - a_dot_d * a_dot_oc);
+    auto C            = oc.magnitude_squared() - a_dot_oc * a_dot_oc - radius * radius;
+    auto discriminant = B * B - T{4} * A * C;
+    T closest_t       = T{-1};
     if (discriminant >= 0) {
-      auto sqrtd                        = std::sqrt(discriminant);
-      std::array<double, 2> t_solutions = {(-B - sqrtd) / (2.0 * A), (-B + sqrtd) / (2.0 * A)};
-      for (double t_side : t_solutions) {
+      auto sqrtd                   = std::sqrt(discriminant);
+      std::array<T, 2> t_solutions = {(-B - sqrtd) / (T{2} * A), (-B + sqrtd) / (T{2} * A)};
+      for (T t_side : t_solutions) {
         if (t_side > t_min and t_side < t_max) {
-          point_vector hit_point = r.at(t_side);
-          double hit_height      = dot(hit_point - center, axis);
+          auto hit_point = r.at(t_side);
+          T hit_height   = dot(hit_point - center, axis);
           if (std::fabs(hit_height) <= HALF_HEIGHT) {
             if (closest_t < 0 or t_side < closest_t) {
               closest_t = t_side;
@@ -96,23 +110,24 @@ namespace render {
   // colisión con cilindro tapas
   // comprueba intersecciones contra los discos que cierran el cilindro (caps) y devuelve el t más
   // cercano válido o -1.0 si no hay intersección
-  double hit_cylinder_caps(ray const & r, double t_min, double t_max, Cylinder const * cyl) {
-    point_vector center(cyl->center_x, cyl->center_y, cyl->center_z);
-    direction_vector axis = unit_vector(direction_vector(cyl->axis_x, cyl->axis_y, cyl->axis_z));
-    double radius = cyl->radius, HALF_HEIGHT = cyl->height / 2.0;
-    double closest_t                                              = -1.0;
-    std::array<std::pair<point_vector, direction_vector>, 2> caps = {
+  template <typename T>
+  T hit_cylinder_caps(basic_ray<T> const & r, T t_min, T t_max, Cylinder const * cyl) {
+    auto center = object_vector<T>(cyl->center_x, cyl->center_y, cyl->center_z);
+    auto axis   = unit_vector(object_vector<T>(cyl->axis_x, cyl->axis_y, cyl->axis_z));
+    auto radius = static_cast<T>(cyl->radius), HALF_HEIGHT = static_cast<T>(cyl->height / 2.0);
+    T closest_t                                                     = T{-1};
+    std::array<std::pair<basic_vector<T>, basic_vector<T>>, 2> caps = {
       std::make_pair(center + (HALF_HEIGHT * axis), axis),
       std::make_pair(center - (HALF_HEIGHT * axis), -axis)};
     for (auto const & cap : caps) {
-      double d_dot_n = dot(r.dir, cap.second);
+      T d_dot_n = dot(r.dir, cap.second);
       if (std::fabs(d_dot_n) < 1e-8) {
         continue;
       }
-      double t_cap = dot(cap.first - r.orig, cap.second) / d_dot_n;
+      T t_cap = dot(cap.first - r.orig, cap.second) / d_dot_n;
       if (t_cap > t_min and t_cap < t_max) {
-        point_vector hit_point = r.at(t_cap);
-        if ((hit_point - cap.first).magnitude() <= radius * radius) {
+        auto hit_point = r.at(t_cap);
+        if ((hit_point - cap.first).magnitude_squared() <= radius * radius) {
           if (closest_t < 0 or t_cap < closest_t) {
             closest_t = t_cap;
           }
@@ -125,11 +140,12 @@ namespace render {
   // colisión con cilindro (combinado)
   // Combina las pruebas laterales y de tapas y devuelve el t más cercano válido entre ambas. -1.0
   // indica ausencia de colisión
-  double hit_cylinder(ray const & r, double t_min, double t_max, Cylinder const * cyl) {
-    double lateral_t = hit_cylinder_lateral(r, t_min, t_max, cyl);
-    double caps_t    = hit_cylinder_caps(r, t_min, t_max, cyl);
+  template <typename T>
+  T hit_cylinder(basic_ray<T> const & r, T t_min, T t_max, Cylinder const * cyl) {
+    T lateral_t = hit_cylinder_lateral(r, t_min, t_max, cyl);
+    T caps_t    = hit_cylinder_caps(r, t_min, t_max, cyl);
     if (lateral_t < 0 and caps_t < 0) {
-      return -1.0;
+      return T{-1};
     }
     if (lateral_t < 0) {
       return caps_t;
@@ -150,7 +166,7 @@ namespace render {
     point_vector center(cyl->center_x, cyl->center_y, cyl->center_z);
     direction_vector axis    = unit_vector(direction_vector(cyl->axis_x, cyl->axis_y, cyl->axis_z));
     double radius            = cyl->radius;
-    double const HALF_HEIGHT = 1.0;
+    double const HALF_HEIGHT = cyl->height / 2.0;
     rec.t                    = t;
     rec.intersect            = r.at(rec.t);
     direction_vector hit_oc  = rec.intersect - center;
@@ -164,7 +180,9 @@ namespace render {
       point_vector P_cap          = cap.first;
       direction_vector N_cap      = cap.second;
       direction_vector vec_to_cap = rec.intersect - P_cap;
-      if (std::fabs(dot(vec_to_cap, N_cap)) < 1e-6 and vec_to_cap.magnitude() <= radius * radius) {
+      if (std::fabs(dot(vec_to_cap, N_cap)) < 1e-6 and
+          vec_to_cap.magnitude_squared() <= radius * radius)
+      {
         outward_normal = N_cap;
         is_cap_hit     = true;
         break;
@@ -179,24 +197,63 @@ namespace render {
     return true;
   }
 
-  // elección general de colisiones
+  // distancia según el tipo de objeto
+  template <typename T>
+  T hit_distance(basic_ray<T> const & r, std::array<T, 2> const & t_range,
+                 ObjectBase const * obj) {
+    switch (obj->type) {
+      case SPHERE_TYPE:
+        return hit_sphere(r, t_range[0], t_range[1], dynamic_cast<Sphere const *>(obj));
+      case CYLINDER_TYPE:
+        return hit_cylinder(r, t_range[0], t_range[1], dynamic_cast<Cylinder const *>(obj));
+      default: return T{-1};
+    }
+  }
+
+  // registro del impacto con un objeto
   // llama a la función específica según el tipo de objeto y procesa el hit para rellenar 'rec'.
   // Devuelve true si hubo intersección
-  bool hit_object(ray const & r, std::array<double, 2> const & t_range, hit_record & rec,
+  bool record_hit(ray const & r, std::array<double, 2> const & t_range, hit_record & rec,
                   ObjectBase const * obj) {
+    double const t = hit_distance(r, t_range, obj);
+    bool hit       = false;
     switch (obj->type) {
       case SPHERE_TYPE:
-      {
-        double t = hit_sphere(r, t_range[0], t_range[1], dynamic_cast<Sphere const *>(obj));
-        return process_sphere_hit(r, t, rec, dynamic_cast<Sphere const *>(obj));
-      }
+        hit = process_sphere_hit(r, t, rec, dynamic_cast<Sphere const *>(obj));
+        break;
       case CYLINDER_TYPE:
-      {
-        double t = hit_cylinder(r, t_range[0], t_range[1], dynamic_cast<Cylinder const *>(obj));
-        return process_cylinder_hit(r, t, rec, dynamic_cast<Cylinder const *>(obj));
-      }
+        hit = process_cylinder_hit(r, t, rec, dynamic_cast<Cylinder const *>(obj));
+        break;
       default: return false;
     }
+    // el material del objeto golpeado viaja en el registro para la dispersión
+    if (hit) {
+      rec.mat_pointer = obj->material_ptr;
+    }
+    return hit;
   }
 
+  // elección general de colisiones: record_hit más las estadísticas de --stats
+  bool hit_object(ray const & r, std::array<double, 2> const & t_range, hit_record & rec,
+                  ObjectBase const * obj) {
+    bool const hit = record_hit(r, t_range, rec, obj);
+    RENDER_STAT(thread_stats().count_intersection(obj->type, hit));
+    RENDER_STAT(thread_stats().count_object(obj->source_line, hit));
+    return hit;
+  }
+
+  // INSTANCIAS (double para el render, float para la búsqueda del modo RENDER_FLOAT)
+
+  template double hit_sphere(ray const &, double, double, Sphere const *);
+  template float hit_sphere(basic_ray<float> const &, float, float, Sphere const *);
+  template double hit_cylinder_lateral(ray const &, double, double, Cylinder const *);
+  template float hit_cylinder_lateral(basic_ray<float> const &, float, float, Cylinder const *);
+  template double hit_cylinder_caps(ray const &, double, double, Cylinder const *);
+  template float hit_cylinder_caps(basic_ray<float> const &, float, float, Cylinder const *);
+  template double hit_cylinder(ray const &, double, double, Cylinder const *);
+  template float hit_cylinder(basic_ray<float> const &, float, float, Cylinder const *);
+  template double hit_distance(ray const &, std::array<double, 2> const &, ObjectBase const *);
+  template float hit_distance(basic_ray<float> const &, std::array<float, 2> const &,
+                              ObjectBase const *);
+
 }  // namespace render
@@ -1,10 +1,44 @@
 #include "../include/hittable.hpp"
 #include "../include/geometry_logic.hpp"
+#include "../include/render_stats.hpp"
+
+#include <array>
 
 namespace render {
 
-  // función que busca la colisión más cercana entre determinado rayo y un objeto
   bool hittable_list::hit(ray const & r, double t_min, double t_max, hit_record & rec) const {
+    if constexpr (SINGLE_PRECISION) {
+      return hit_refined(r, t_min, t_max, rec);
+    }
+    return hit_all(r, t_min, t_max, rec);
+  }
+
+  bool hittable_list::hit_refined(ray const & r, double t_min, double t_max,
+                                  hit_record & rec) const {
+    basic_ray<float> const fast(vector_cast<float>(r.orig), vector_cast<float>(r.dir));
+    std::array<float, 2> range{static_cast<float>(t_min), static_cast<float>(t_max)};
+    ObjectBase const * closest = nullptr;
+    for (auto const & object : objects) {
+      float const t  = hit_distance(fast, range, object);
+      bool const hit = t >= 0.0F;
+      RENDER_STAT(thread_stats().count_intersection(object->type, hit));
+      RENDER_STAT(thread_stats().count_object(object->source_line, hit));
+      if (hit) {
+        closest  = object;
+        range[1] = t;
+      }
+    }
+    if (closest == nullptr) {
+      return false;
+    }
+    if (record_hit(r, std::array<double, 2>{t_min, t_max}, rec, closest)) {
+      return true;
+    }
+    return hit_all(r, t_min, t_max, rec);
+  }
+
+  // función que busca la colisión más cercana entre determinado rayo y un objeto
+  bool hittable_list::hit_all(ray const & r, double t_min, double t_max, hit_record & rec) const {
     // almacena el registro del golpe más cercano temporalmente
     hit_record temp_rec;
 
@@ -3,22 +3,63 @@
 #include "../include/materials.hpp"
 #include "../include/math_utilities.hpp"
 #include "../include/ray.hpp"
+#include "../include/render_stats.hpp"
 #include "../include/vector.hpp"
 
 #include <cmath>
+#include <numbers>
 
 namespace render {
 
+  namespace {
+
+    // desplazamiento aleatorio de un rebote, del flujo de muestras si lo hay o del RNG
+    direction_vector scatter_offset(ScatterIO const & io, double min, double max) {
+      return io.samples != nullptr ? random_vec(*io.samples, min, max)
+                                   : random_vec(*io.rng, min, max);
+    }
+
+    double next_uniform(ScatterIO const & io) {
+      return io.samples != nullptr ? io.samples->next() : io.rng->random_double();
+    }
+
+  }  // namespace
+
+  // muestreo del hemisferio con densidad coseno
+  // punto uniforme en el disco unidad proyectado sobre el hemisferio (método de Malley), expresado
+  // en una base ortonormal alrededor de la normal construida sin ramas (Duff et al., 2017)
+  direction_vector cosine_hemisphere(normal_vector const & normal, double u1, double u2) {
+    double const sign  = std::copysign(1.0, normal.get_z());
+    double const a     = -1.0 / (sign + normal.get_z());
+    double const b     = normal.get_x() * normal.get_y() * a;
+    direction_vector const tangent(1.0 + sign * normal.get_x() * normal.get_x() * a, sign * b,
+                                   -sign * normal.get_x());
+    direction_vector const bitangent(b, sign + normal.get_y() * normal.get_y() * a,
+                                     -normal.get_y());
+    double const phi    = 2.0 * std::numbers::pi * u1;
+    double const radius = std::sqrt(u2);
+    double const height = std::sqrt(1.0 - u2);
+    return radius * std::cos(phi) * tangent + radius * std::sin(phi) * bitangent +
+           height * normal;
+  }
+
   // lógica de dispersión material mate
   // calcula un rayo dispersado con dirección aleatoria alrededor de la normal y la atenuación
-  // asociada al material
+  // asociada al material. Con densidad coseno la atenuación es directamente la reflectancia: el
+  // coseno de la ecuación de render se cancela con la densidad de la dirección
   bool scatter_matte(hit_record const & rec, MatteMaterial const * mat, ScatterIO & io) {
-    direction_vector random_offset     = random_vec(*io.rng);
-    direction_vector scatter_direction = rec.normal + random_offset;
-    if (scatter_direction.near_zero()) {
-      scatter_direction = rec.normal;
+    direction_vector scatter_direction;
+    if (io.matte_scatter == MatteScatter::COSINE) {
+      double const u1   = next_uniform(io);
+      scatter_direction = cosine_hemisphere(rec.normal, u1, next_uniform(io));
     } else {
-      scatter_direction = unit_vector(scatter_direction);
+      direction_vector random_offset = scatter_offset(io, -1.0, 1.0);
+      scatter_direction              = rec.normal + random_offset;
+      if (scatter_direction.near_zero()) {
+        scatter_direction = rec.normal;
+      } else {
+        scatter_direction = unit_vector(scatter_direction);
+      }
     }
     *io.scattered   = ray(rec.intersect, scatter_direction);
     *io.attenuation = color_vector(mat->reflectance_r, mat->reflectance_g, mat->reflectance_b);
@@ -33,7 +74,7 @@ namespace render {
     double diffusion                     = mat->diffusion;
     direction_vector unit_dir            = unit_vector(r_in.dir);
     direction_vector reflected           = unit_dir - 2.0 * dot(unit_dir, rec.normal) * rec.normal;
-    direction_vector phi_diffusion       = random_vec(*io.rng, -diffusion, diffusion);
+    direction_vector phi_diffusion       = scatter_offset(io, -diffusion, diffusion);
     direction_vector scattered_direction = unit_vector(reflected + phi_diffusion);
     *io.scattered                        = ray(rec.intersect, scattered_direction);
     *io.attenuation = color_vector(mat->reflectance_r, mat->reflectance_g, mat->reflectance_b);
@@ -73,15 +114,22 @@ namespace render {
     if (base_mat == nullptr) {
       return false;
     }
+    bool bounced = false;
     switch (base_mat->type) {
-      case MATTE_TYPE: return scatter_matte(rec, dynamic_cast<MatteMaterial const *>(base_mat), io);
+      case MATTE_TYPE:
+        bounced = scatter_matte(rec, dynamic_cast<MatteMaterial const *>(base_mat), io);
+        break;
       case METAL_TYPE:
-        return scatter_metal(r_in, rec, dynamic_cast<MetalMaterial const *>(base_mat), io);
+        bounced = scatter_metal(r_in, rec, dynamic_cast<MetalMaterial const *>(base_mat), io);
+        break;
       case REFRACTIVE_TYPE:
-        return scatter_refractive(r_in, rec, dynamic_cast<RefractiveMaterial const *>(base_mat),
-                                  io);
+        bounced = scatter_refractive(r_in, rec,
+                                     dynamic_cast<RefractiveMaterial const *>(base_mat), io);
+        break;
       default: return false;
     }
+    RENDER_STAT(thread_stats().count_scatter(base_mat->type, bounced));
+    return bounced;
   }
 
 }  // namespace render
@@ -3,18 +3,66 @@
 namespace render {
 
   // RNG: constructor y generación de dobles
-  // implementación del generador Mersenne-Twister y funciones auxiliares para obtener dobles en
-  // [0,1) y en [min,max)
-  RNG::RNG(uint64_t seed) : generator(seed) { }
+  // implementación del generador Mersenne-Twister (o del bloque de xoshiro256+) y funciones
+  // auxiliares para obtener dobles en [0,1) y en [min,max)
+  RNG::RNG(uint64_t seed, RngEngine engine) : generator(seed) {
+    if (engine == RngEngine::XOSHIRO) {
+      block_generator.emplace(seed);
+    }
+  }
 
   double RNG::random_double() {
-    return std::generate_canonical<double, 10>(generator);
+    if (!block_generator) {
+      return std::generate_canonical<double, 10>(generator);
+    }
+    if (next == block.size()) {
+      block_origin = block_generator;
+      block_generator->fill(block);
+      next = 0;
+    }
+    return block[next++];
   }
 
   double RNG::random_double(double min, double max) {
     return min + (max - min) * random_double();
   }
 
+  // estado del generador
+  // se serializa con los operadores de flujo de std::mt19937_64, que garantizan que un generador
+  // restaurado produce exactamente la misma secuencia que el original. Con xoshiro se guarda el
+  // estado previo al bloque en curso y la posición dentro de él: al cargar se vuelve a generar
+  void RNG::save_state(std::ostream & out) const {
+    if (!block_generator) {
+      out << generator;
+      return;
+    }
+    (next < block.size() ? *block_origin : *block_generator).save_state(out);
+    out << ' ' << next;
+  }
+
+  bool RNG::load_state(std::istream & in) {
+    if (!block_generator) {
+      std::mt19937_64 restored;
+      if (!(in >> restored)) {
+        return false;
+      }
+      generator = restored;
+      return true;
+    }
+    BlockRNG restored(0);
+    std::size_t position = 0;
+    if (!restored.load_state(in) or !(in >> position) or position > block.size()) {
+      return false;
+    }
+    block_generator = restored;
+    next            = position;
+    if (next < block.size()) {
+      block_origin = restored;
+      block_generator->fill(block);
+    }
+    return true;
+  }
+
   // generación de vector aleatorio
   // devuelve un vector cuyas componentes están uniformemente distribuidas en [min, max] usando el
   // RNG provisto
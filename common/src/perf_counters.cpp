@@ -0,0 +1,175 @@
+#include "../include/perf_counters.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <string_view>
+
+#ifdef __linux__
+  #include <linux/perf_event.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace render {
+
+  namespace {
+
+    constexpr std::array<std::string_view, PerfCounters::EVENT_COUNT> EVENT_NAMES{
+      "cycles", "instructions", "L1D misses", "LLC misses", "branch misses"};
+
+#ifdef __linux__
+    // (tipo, configuración) de cada contador en el orden de PerfCounters::Event
+    constexpr std::array<std::pair<std::uint32_t, std::uint64_t>, PerfCounters::EVENT_COUNT>
+        EVENT_CONFIGS{
+          {{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+           {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+           {PERF_TYPE_HW_CACHE,
+            PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8U) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U)},
+           {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+           {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}}
+    };
+
+    // contador del hilo actual en cualquier CPU, solo en modo usuario
+    int open_event(std::uint32_t type, std::uint64_t config) {
+      perf_event_attr attr{};
+      attr.size           = sizeof(attr);
+      attr.type           = type;
+      attr.config         = config;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    // valor escalado por enabled/running cuando el kernel reparte el PMU entre contadores
+    std::uint64_t read_event(int fd) {
+      std::array<std::uint64_t, 3> raw{};  // valor, tiempo habilitado, tiempo contando
+      if (::read(fd, raw.data(), sizeof(raw)) != static_cast<ssize_t>(sizeof(raw))) {
+        return 0;
+      }
+      if (raw[2] == 0 or raw[2] == raw[1]) {
+        return raw[0];
+      }
+      double const scale = static_cast<double>(raw[1]) / static_cast<double>(raw[2]);
+      return static_cast<std::uint64_t>(static_cast<double>(raw[0]) * scale);
+    }
+#endif
+
+    // valor por rayo o "n/d" si el contador no está disponible
+    void write_per_ray(std::ostream & out, bool available, std::uint64_t value,
+                       std::uint64_t rays) {
+      out << std::setw(14);
+      if (!available or rays == 0) {
+        out << "n/d";
+      } else {
+        out << static_cast<double>(value) / static_cast<double>(rays);
+      }
+    }
+
+  }  // namespace
+
+  PerfCounters & PerfCounters::instance() {
+    static PerfCounters counters;
+    return counters;
+  }
+
+  PerfCounters::PerfCounters() {
+    fds_.fill(-1);
+  }
+
+  PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int const fd : fds_) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+#endif
+  }
+
+  bool PerfCounters::open() {
+    active_         = true;
+    owner_          = std::this_thread::get_id();
+    int first_error = 0;
+#ifdef __linux__
+    for (std::size_t i = 0; i < EVENT_COUNT; ++i) {
+      fds_[i] = open_event(EVENT_CONFIGS[i].first, EVENT_CONFIGS[i].second);
+      if (fds_[i] < 0 and first_error == 0) {
+        first_error = errno;
+      }
+    }
+#endif
+    bool const any = std::ranges::any_of(fds_, [](int fd) { return fd >= 0; });
+    if (!any) {
+      std::cerr << "Aviso: contadores hardware no disponibles ("
+                << (first_error != 0 ? std::strerror(first_error) : "perf_event_open no soportado")
+                << "); --perf solo mostrará tiempos\n";
+    } else if (first_error != 0) {
+      std::cerr << "Aviso: algunos contadores hardware no están disponibles ("
+                << std::strerror(first_error) << ")\n";
+    }
+    return any;
+  }
+
+  PerfCounters::Reading PerfCounters::read() const {
+    Reading values{};
+#ifdef __linux__
+    for (std::size_t i = 0; i < EVENT_COUNT; ++i) {
+      if (fds_[i] >= 0) {
+        values[i] = read_event(fds_[i]);
+      }
+    }
+#endif
+    return values;
+  }
+
+  void PerfCounters::add_phase(char const * name, Reading const & delta,
+                               std::chrono::duration<double> wall) {
+    std::lock_guard const lock(mutex_);
+    auto it = std::ranges::find(phases_, std::string_view(name), &PhaseTotals::name);
+    if (it == phases_.end()) {
+      it = phases_.insert(phases_.end(), PhaseTotals{.name = name});
+    }
+    ++it->calls;
+    it->seconds += wall.count();
+    for (std::size_t i = 0; i < EVENT_COUNT; ++i) {
+      it->values[i] += delta[i];
+    }
+  }
+
+  void PerfCounters::write_report(std::ostream & out, std::uint64_t rays) const {
+    std::lock_guard const lock(mutex_);
+    auto const flags     = out.flags();
+    auto const precision = out.precision(6);
+    out << std::fixed << "Contadores hardware por fase (" << rays
+        << " rayos primarios; valores por rayo):\n"
+        << std::left << std::setw(24) << "fase" << std::right << std::setw(9) << "llamadas"
+        << std::setw(12) << "tiempo (s)" << std::setw(8) << "IPC";
+    for (std::size_t i = 0; i < EVENT_COUNT; ++i) {
+      out << std::setw(14) << EVENT_NAMES[i];
+    }
+    out << '\n';
+    for (PhaseTotals const & phase : phases_) {
+      out << std::left << std::setw(24) << phase.name << std::right << std::setw(9) << phase.calls
+          << std::setw(12) << phase.seconds << std::setw(8);
+      if (available(CYCLES) and available(INSTRUCTIONS) and phase.values[CYCLES] > 0) {
+        out << static_cast<double>(phase.values[INSTRUCTIONS]) /
+                   static_cast<double>(phase.values[CYCLES]);
+      } else {
+        out << "n/d";
+      }
+      for (std::size_t i = 0; i < EVENT_COUNT; ++i) {
+        write_per_ray(out, available(static_cast<Event>(i)), phase.values[i], rays);
+      }
+      out << '\n';
+    }
+    out.flags(flags);
+    out.precision(precision);
+  }
+
+}  // namespace render
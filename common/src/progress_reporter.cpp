@@ -0,0 +1,89 @@
+#include "../include/progress_reporter.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+
+#ifdef __linux__
+  #include <sys/resource.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace render {
+
+  namespace {
+
+    // prioridad del hilo de progreso en Linux (nice de 0 a 19)
+    constexpr int REPORTER_NICE = 19;
+
+    // baja la prioridad del hilo actual (no del proceso) para no quitar CPU al render
+    void lower_thread_priority() {
+#ifdef __linux__
+      auto const tid = static_cast<id_t>(syscall(SYS_gettid));
+      (void) setpriority(PRIO_PROCESS, tid, REPORTER_NICE);
+#endif
+    }
+
+  }  // namespace
+
+  ProgressReporter::ProgressReporter(std::uint64_t total, char const * unit, bool quiet)
+      : total_(total), unit_(unit), start_(std::chrono::steady_clock::now()), finished_(quiet) {
+    if (!quiet) {
+      worker_ = std::thread([this] { run(); });
+    }
+  }
+
+  ProgressReporter::~ProgressReporter() {
+    finish();
+  }
+
+  void ProgressReporter::finish() {
+    {
+      std::lock_guard const lock(mutex_);
+      if (finished_) {
+        return;
+      }
+      finished_ = true;
+      stopping_ = true;
+    }
+    wake_.notify_one();
+    worker_.join();
+    write_line(std::cerr);
+    std::cerr << '\n';
+  }
+
+  void ProgressReporter::write_line(std::ostream & out) const {
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start_;
+    auto const done      = static_cast<double>(this->done());
+    auto const flags     = out.flags();
+    auto const precision = out.precision(1);
+    out << std::fixed << "\rProgreso: ";
+    if (total_ > 0) {
+      out << 100.0 * done / static_cast<double>(total_) << "% (" << this->done() << '/' << total_
+          << ' ' << unit_ << ")";
+    } else {
+      out << this->done() << ' ' << unit_;
+    }
+    double const seconds = elapsed.count();
+    if (seconds > 0) {
+      out << ", " << std::setprecision(2) << static_cast<double>(rays()) / seconds / 1e6
+          << " Mrayos/s" << std::setprecision(1);
+    }
+    if (total_ > 0 and done > 0 and this->done() < total_) {
+      out << ", ETA " << seconds * (static_cast<double>(total_) - done) / done << " s";
+    }
+    out << "   " << std::flush;
+    out.flags(flags);
+    out.precision(precision);
+  }
+
+  void ProgressReporter::run() {
+    lower_thread_priority();
+    std::unique_lock lock(mutex_);
+    while (!wake_.wait_for(lock, REPORT_PERIOD, [this] { return stopping_; })) {
+      write_line(std::cerr);
+    }
+  }
+
+}  // namespace render
@@ -0,0 +1,234 @@
+#include "../include/render_stats.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace render {
+
+  namespace {
+
+    constexpr std::array<std::string_view, RenderStats::OBJECT_TYPES> OBJECT_NAMES{"sphere",
+                                                                                   "cylinder"};
+    constexpr std::array<std::string_view, RenderStats::MATERIAL_TYPES> MATERIAL_NAMES{
+      "matte", "metal", "refractive"};
+
+    // contadores de los hilos vivos y suma de los que ya terminaron
+    struct StatsRegistry {
+      std::mutex mutex;
+      ThreadStatsSlot * live = nullptr;  // cabeza de la lista de hilos vivos
+      RenderStats retired;
+    };
+
+    StatsRegistry & registry() {
+      static StatsRegistry instance;
+      return instance;
+    }
+
+    template <std::size_t N>
+    void add_arrays(std::array<std::uint64_t, N> & dst, std::array<std::uint64_t, N> const & src) {
+      for (std::size_t i = 0; i < N; ++i) {
+        dst[i] += src[i];
+      }
+    }
+
+    // profundidad del último rebote con rayos (para no imprimir la cola de ceros)
+    std::size_t deepest_bounce(RenderStats const & stats) {
+      std::size_t depth = 0;
+      for (std::size_t i = 1; i < stats.secondary_rays.size(); ++i) {
+        if (stats.secondary_rays[i] != 0) {
+          depth = i;
+        }
+      }
+      return depth;
+    }
+
+    template <std::size_t N>
+    void write_json_array(std::ostream & out, std::array<std::uint64_t, N> const & values,
+                          std::size_t first, std::size_t last) {
+      out << '[';
+      for (std::size_t i = first; i <= last and i < N; ++i) {
+        out << (i == first ? "" : ", ") << values[i];
+      }
+      out << ']';
+    }
+
+    template <std::size_t N>
+    void write_json_by_name(std::ostream & out, std::array<std::string_view, N> const & names,
+                            std::array<std::uint64_t, N> const & values) {
+      out << '{';
+      for (std::size_t i = 0; i < N; ++i) {
+        out << (i == 0 ? "" : ", ") << '"' << names[i] << "\": " << values[i];
+      }
+      out << '}';
+    }
+
+    // líneas del fichero de escena (la 1 en la posición 1); vacío si no se puede leer
+    std::vector<std::string> read_source_lines(std::string const & filename) {
+      std::vector<std::string> lines(1);
+      std::ifstream file(filename);
+      for (std::string line; std::getline(file, line);) {
+        lines.push_back(line);
+      }
+      return lines;
+    }
+
+    double percent(std::uint64_t part, std::uint64_t whole) {
+      return whole == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+    }
+
+    // fila del perfil: pruebas, parte del total, aciertos, tasa de acierto y declaración
+    void write_object_row(std::ostream & out, ObjectCounts const & counts,
+                          std::uint64_t total_tests, std::string_view source) {
+      out << std::setw(14) << counts.tests << std::setw(9) << percent(counts.tests, total_tests)
+          << '%' << std::setw(14) << counts.hits << std::setw(9)
+          << percent(counts.hits, counts.tests) << "%  " << source << '\n';
+    }
+
+  }  // namespace
+
+  void RenderStats::merge(RenderStats const & other) {
+    primary_rays           += other.primary_rays;
+    ray_hits               += other.ray_hits;
+    ray_misses             += other.ray_misses;
+    max_depth_terminations += other.max_depth_terminations;
+    add_arrays(secondary_rays, other.secondary_rays);
+    add_arrays(intersection_tests, other.intersection_tests);
+    add_arrays(intersection_hits, other.intersection_hits);
+    add_arrays(scattered, other.scattered);
+    add_arrays(absorbed, other.absorbed);
+    if (object_counts.size() < other.object_counts.size()) {
+      object_counts.resize(other.object_counts.size());
+    }
+    for (std::size_t i = 0; i < other.object_counts.size(); ++i) {
+      object_counts[i].tests += other.object_counts[i].tests;
+      object_counts[i].hits  += other.object_counts[i].hits;
+    }
+  }
+
+  void enable_object_profile(int max_source_line) {
+    thread_stats().object_counts.resize(static_cast<std::size_t>(max_source_line) + 1);
+    object_profile_active = true;
+  }
+
+  void RenderStats::write_text(std::ostream & out) const {
+    out << "Estadísticas del render:\n"
+        << "  Rayos primarios:          " << primary_rays << '\n';
+    for (std::size_t depth = 1; depth <= deepest_bounce(*this); ++depth) {
+      out << "  Rayos secundarios (rebote " << depth << "): " << secondary_rays[depth] << '\n';
+    }
+    out << "  Rayos con impacto:        " << ray_hits << '\n'
+        << "  Rayos al fondo:           " << ray_misses << '\n';
+    for (std::size_t i = 0; i < OBJECT_TYPES; ++i) {
+      out << "  Pruebas " << OBJECT_NAMES[i] << ": " << intersection_tests[i]
+          << " (aciertos: " << intersection_hits[i] << ")\n";
+    }
+    for (std::size_t i = 0; i < MATERIAL_TYPES; ++i) {
+      out << "  Dispersión " << MATERIAL_NAMES[i] << ": " << scattered[i]
+          << " rebotes, " << absorbed[i] << " absorciones\n";
+    }
+    out << "  Caminos cortados por max_depth: " << max_depth_terminations << '\n';
+  }
+
+  void RenderStats::write_json(std::ostream & out) const {
+    out << "{\"primary_rays\": " << primary_rays << ", \"secondary_rays_by_depth\": ";
+    write_json_array(out, secondary_rays, 1, deepest_bounce(*this));
+    out << ", \"ray_hits\": " << ray_hits << ", \"ray_misses\": " << ray_misses
+        << ", \"intersection_tests\": ";
+    write_json_by_name(out, OBJECT_NAMES, intersection_tests);
+    out << ", \"intersection_hits\": ";
+    write_json_by_name(out, OBJECT_NAMES, intersection_hits);
+    out << ", \"scattered\": ";
+    write_json_by_name(out, MATERIAL_NAMES, scattered);
+    out << ", \"absorbed\": ";
+    write_json_by_name(out, MATERIAL_NAMES, absorbed);
+    out << ", \"max_depth_terminations\": " << max_depth_terminations << "}\n";
+  }
+
+  ThreadStatsSlot::ThreadStatsSlot() {
+    StatsRegistry & reg = registry();
+    std::lock_guard const lock(reg.mutex);
+    next = reg.live;
+    if (next != nullptr) {
+      next->prev = this;
+    }
+    reg.live = this;
+  }
+
+  ThreadStatsSlot::~ThreadStatsSlot() {
+    StatsRegistry & reg = registry();
+    std::lock_guard const lock(reg.mutex);
+    reg.retired.merge(stats);
+    (prev != nullptr ? prev->next : reg.live) = next;
+    if (next != nullptr) {
+      next->prev = prev;
+    }
+  }
+
+  RenderStats collect_stats() {
+    StatsRegistry & reg = registry();
+    std::lock_guard const lock(reg.mutex);
+    RenderStats total = reg.retired;
+    for (ThreadStatsSlot const * slot = reg.live; slot != nullptr; slot = slot->next) {
+      total.merge(slot->stats);
+    }
+    return total;
+  }
+
+  void write_object_profile(std::ostream & out, std::string const & scene_file,
+                            std::size_t top_n) {
+    if (!stats_enabled()) {
+      std::cerr << "Perfil por objeto no disponible: compilado con ENABLE_RENDER_STATS=OFF\n";
+      return;
+    }
+    RenderStats const total = collect_stats();
+    std::vector<std::size_t> ranked;
+    std::uint64_t total_tests = 0;
+    for (std::size_t line = 0; line < total.object_counts.size(); ++line) {
+      if (total.object_counts[line].tests > 0) {
+        ranked.push_back(line);
+        total_tests += total.object_counts[line].tests;
+      }
+    }
+    auto const tests_of = [&total](std::size_t line) { return total.object_counts[line].tests; };
+    std::ranges::stable_sort(ranked, std::greater{}, tests_of);
+    std::size_t const tested = ranked.size();
+    ranked.resize(std::min(top_n, tested));
+
+    std::vector<std::string> const source = read_source_lines(scene_file);
+    auto const flags     = out.flags();
+    auto const precision = out.precision(2);
+    out << std::fixed << "Objetos con más pruebas de intersección (" << ranked.size() << " de "
+        << tested << " objetos, " << total_tests << " pruebas):\n"
+        // "línea" ocupa 6 bytes en UTF-8 para 5 columnas
+        << std::setw(8) << "línea" << std::setw(14) << "pruebas" << std::setw(10) << "total"
+        << std::setw(14) << "aciertos" << std::setw(10) << "acierto" << "  declaración\n";
+    for (std::size_t const line : ranked) {
+      out << std::setw(7) << line;
+      write_object_row(out, total.object_counts[line], total_tests,
+                       line < source.size() ? source[line] : "(sin línea de escena)");
+    }
+    out.flags(flags);
+    out.precision(precision);
+  }
+
+  void write_stats_report(std::ostream & out, bool json) {
+    if (!stats_enabled()) {
+      std::cerr << "Estadísticas no disponibles: compilado con ENABLE_RENDER_STATS=OFF\n";
+      return;
+    }
+    RenderStats const total = collect_stats();
+    if (json) {
+      total.write_json(out);
+    } else {
+      total.write_text(out);
+    }
+  }
+
+}  // namespace render
@@ -0,0 +1,124 @@
+#include "../include/renderer.hpp"
+#include "../include/alloc_counter.hpp"
+#include "../include/config_parser.hpp"
+#include "../include/materials.hpp"
+#include "../include/objects.hpp"
+#include "../include/perf_counters.hpp"
+#include "../include/render_stats.hpp"
+#include "../include/trace.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+namespace render {
+
+  namespace {
+
+    // materiales y objetos leídos del fichero de escena
+    struct SceneStorage {
+      std::vector<MatteMaterial> matte_materials;
+      std::vector<MetalMaterial> metal_materials;
+      std::vector<RefractiveMaterial> refractive_materials;
+      std::vector<Sphere> spheres;
+      std::vector<Cylinder> cylinders;
+
+      [[nodiscard]] SceneOutput output() {
+        return {matte_materials, metal_materials, refractive_materials, spheres, cylinders};
+      }
+    };
+
+    // activa los perfiladores que piden las opciones antes de empezar
+    void enable_profilers(RenderOptions const & options) {
+      if (!options.trace_file.empty()) {
+        TraceRecorder::instance().enable();
+      }
+      if (options.perf) {
+        (void) PerfCounters::instance().open();
+      }
+      if (options.alloc_stats) {
+        AllocationProfile::instance().enable();
+      }
+    }
+
+    bool load_inputs(RenderOptions const & options, ConfigParams & config, SceneOutput & scene) {
+      if (!parse_config(options.config_file, config)) {
+        std::cerr << "Error: No se pudo parsear el archivo de configuración." << '\n';
+        return false;
+      }
+      if (!parse_scene(options.scene_file, scene)) {
+        std::cerr << "Error: No se pudo parsear el archivo de escena." << '\n';
+        return false;
+      }
+      return link_materials(scene);
+    }
+
+    // última línea del fichero de escena que declara un objeto (para --object-profile)
+    int max_source_line(SceneOutput const & scene) {
+      int line = 0;
+      for (Sphere const & sph : scene.spheres.get()) {
+        line = std::max(line, sph.source_line);
+      }
+      for (Cylinder const & cyl : scene.cylinders.get()) {
+        line = std::max(line, cyl.source_line);
+      }
+      return line;
+    }
+
+    // informes finales comunes a los backends; false si el render asignó memoria con
+    // --alloc-stats o no se pudo escribir la traza
+    bool write_reports(RenderOptions const & options, std::uint64_t primary_rays) {
+      if (options.stats) {
+        write_stats_report(std::cout, options.stats_json);
+      }
+      if (options.object_profile > 0) {
+        write_object_profile(std::cout, options.scene_file,
+                             static_cast<std::size_t>(options.object_profile));
+      }
+      if (options.perf) {
+        PerfCounters::instance().write_report(std::cout, primary_rays);
+      }
+      if (options.alloc_stats) {
+        auto const & allocations = AllocationProfile::instance();
+        allocations.write_report(std::cout);
+        if (allocations.category_total("render").allocations > 0) {
+          std::cerr << "Error: El bucle de render ha asignado memoria dinámica\n";
+          return false;
+        }
+      }
+      return options.trace_file.empty() or TraceRecorder::instance().write(options.trace_file);
+    }
+
+  }  // namespace
+
+  int run_renderer(std::vector<std::string> const & args, Backend default_backend) {
+    auto const start_time = std::chrono::steady_clock::now();
+    RenderOptions options;
+    if (!parse_options(args, options)) {
+      std::cerr << usage(args.empty() ? "render" : args[0]);
+      return 1;
+    }
+    enable_profilers(options);
+
+    ConfigParams config;
+    SceneStorage storage;
+    SceneOutput scene = storage.output();
+    if (!load_inputs(options, config, scene)) {
+      return 1;
+    }
+    if (options.object_profile > 0) {
+      enable_object_profile(max_source_line(scene));
+    }
+
+    Backend const backend                    = options.backend.value_or(default_backend);
+    std::unique_ptr<Renderer> const renderer = make_renderer(backend);
+    RenderJob const job{
+      .options = options, .config = config, .scene = scene, .start_time = start_time};
+    std::uint64_t primary_rays = 0;
+    if (!renderer->render(job, primary_rays)) {
+      return 1;
+    }
+    return write_reports(options, primary_rays) ? 0 : 1;
+  }
+
+}  // namespace render
@@ -0,0 +1,17 @@
+#include "../include/renderer.hpp"
+
+#include "../../aos/include/aos_renderer.hpp"
+#include "../../soa/include/render_soa.hpp"
+
+#include <memory>
+
+namespace render {
+
+  std::unique_ptr<Renderer> make_renderer(Backend backend) {
+    if (backend == Backend::SOA) {
+      return std::make_unique<soa::SOARenderer>();
+    }
+    return std::make_unique<aos::AOSRenderer>();
+  }
+
+}  // namespace render
@@ -0,0 +1,365 @@
+#include "../include/sampler.hpp"
+#include "../include/trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace render {
+
+  namespace {
+
+    // mayor double por debajo de 1 (las secuencias devuelven valores en [0, 1))
+    constexpr double ONE_MINUS_EPSILON = 0x1.fffffffffffffp-1;
+
+    // 2^-32: pasa un entero de 32 bits a [0, 1)
+    constexpr double INV_2_POW_32 = 0x1p-32;
+
+    // parte fraccionaria de la razón áurea: rotación por muestra del ruido azul
+    constexpr double GOLDEN_RATIO_CONJUGATE = 0.618'033'988'749'894'9;
+
+    // finalizador de splitmix64
+    constexpr std::uint64_t mix64(std::uint64_t x) {
+      x ^= x >> 30U;
+      x *= 0xbf58'476d'1ce4'e5b9ULL;
+      x ^= x >> 27U;
+      x *= 0x94d0'49bb'1331'11ebULL;
+      x ^= x >> 31U;
+      return x;
+    }
+
+    constexpr std::uint64_t hash(std::uint64_t a, std::uint64_t b) {
+      return mix64(a ^ (b + 0x9e37'79b9'7f4a'7c15ULL + (a << 6U) + (a >> 2U)));
+    }
+
+    constexpr std::uint64_t pixel_key(SamplePoint const & point) {
+      return static_cast<std::uint64_t>(static_cast<std::uint32_t>(point.x)) |
+             (static_cast<std::uint64_t>(static_cast<std::uint32_t>(point.y)) << 32U);
+    }
+
+    // --- Halton ---
+
+    // bases de las primeras 32 dimensiones
+    constexpr std::array<std::uint32_t, 32> PRIMES{
+      2,  3,  5,  7,  11, 13, 17, 19, 23, 29, 31,  37,  41,  43,  47,  53,
+      59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131,
+    };
+
+    // siguiente dígito en base 'base' de la fracción fraction / 2^64: la parte entera de
+    // fraction * base (producto de 96 bits hecho por mitades de 32 bits); fraction se queda con
+    // la parte fraccionaria
+    constexpr std::uint32_t next_digit(std::uint64_t & fraction, std::uint32_t base) {
+      std::uint64_t const low  = (fraction & 0xffff'ffffULL) * base;
+      std::uint64_t const high = (fraction >> 32U) * base + (low >> 32U);
+      fraction                 = (high << 32U) | (low & 0xffff'ffffULL);
+      return static_cast<std::uint32_t>(high >> 32U);
+    }
+
+    // inverso radical de 'index' en base 'base' con cada dígito desplazado (módulo la base) por
+    // un valor pseudoaleatorio propio de su posición: los dígitos sucesivos de seed / 2^64 en la
+    // misma base, de modo que un solo hash da los desplazamientos de todos. Los dígitos se
+    // recorren hasta una resolución de 2^-32, así que también se desplazan los ceros a la
+    // izquierda del índice (sin división una vez agotado el índice)
+    double scrambled_radical_inverse(std::uint32_t index, std::uint32_t base, std::uint64_t seed) {
+      double const inv_base = 1.0 / static_cast<double>(base);
+      double result         = 0.0;
+      for (double weight = inv_base; weight >= INV_2_POW_32; weight *= inv_base) {
+        std::uint32_t digit = next_digit(seed, base);
+        if (index != 0) {
+          digit += index % base;
+          digit  = digit >= base ? digit - base : digit;
+          index /= base;
+        }
+        result += static_cast<double>(digit) * weight;
+      }
+      return std::min(result, ONE_MINUS_EPSILON);
+    }
+
+    // --- Sobol ---
+
+    constexpr unsigned SOBOL_BITS       = 32;
+    constexpr std::uint32_t SOBOL_GROUP = 4;
+
+    // polinomios primitivos y números de dirección iniciales de las dimensiones 2-4 de la tabla
+    // de Joe y Kuo (la primera dimensión es la secuencia de van der Corput)
+    struct SobolPolynomial {
+      unsigned degree;
+      std::uint32_t coefficients;
+      std::array<std::uint32_t, 3> initial;
+    };
+
+    constexpr std::array<SobolPolynomial, SOBOL_GROUP - 1> SOBOL_POLYNOMIALS{
+      {{1, 0, {1, 0, 0}}, {2, 1, {1, 3, 0}}, {3, 1, {1, 3, 1}}}
+    };
+
+    using SobolMatrix = std::array<std::uint32_t, SOBOL_BITS>;
+
+    constexpr SobolMatrix sobol_directions(SobolPolynomial const & poly) {
+      SobolMatrix v{};
+      unsigned const s = poly.degree;
+      for (unsigned k = 0; k < SOBOL_BITS; ++k) {
+        if (k < s) {
+          v[k] = poly.initial[k] << (SOBOL_BITS - 1 - k);
+          continue;
+        }
+        std::uint32_t value = v[k - s] ^ (v[k - s] >> s);
+        for (unsigned l = 1; l < s; ++l) {
+          if (((poly.coefficients >> (s - 1 - l)) & 1U) != 0) {
+            value ^= v[k - l];
+          }
+        }
+        v[k] = value;
+      }
+      return v;
+    }
+
+    constexpr std::array<SobolMatrix, SOBOL_GROUP> make_sobol_matrices() {
+      std::array<SobolMatrix, SOBOL_GROUP> matrices{};
+      for (unsigned k = 0; k < SOBOL_BITS; ++k) {
+        matrices[0][k] = 1U << (SOBOL_BITS - 1 - k);
+      }
+      for (std::size_t d = 1; d < SOBOL_GROUP; ++d) {
+        matrices[d] = sobol_directions(SOBOL_POLYNOMIALS[d - 1]);
+      }
+      return matrices;
+    }
+
+    constexpr std::array<SobolMatrix, SOBOL_GROUP> SOBOL_MATRICES = make_sobol_matrices();
+
+    // el índice llega barajado (sus 32 bits al azar): se recorren todos los bits sin saltos, con
+    // una máscara por bit, en lugar de ramas que el predictor fallaría la mitad de las veces
+    constexpr std::uint32_t sobol_sample(std::uint32_t index, std::uint32_t component) {
+      SobolMatrix const & matrix = SOBOL_MATRICES[component];
+      std::uint32_t result       = 0;
+      for (unsigned bit = 0; bit < SOBOL_BITS; ++bit) {
+        std::uint32_t const mask  = 0U - ((index >> bit) & 1U);
+        result                   ^= matrix[bit] & mask;
+      }
+      return result;
+    }
+
+    constexpr std::uint32_t reverse_bits(std::uint32_t x) {
+      x = ((x >> 1U) & 0x5555'5555U) | ((x & 0x5555'5555U) << 1U);
+      x = ((x >> 2U) & 0x3333'3333U) | ((x & 0x3333'3333U) << 2U);
+      x = ((x >> 4U) & 0x0f0f'0f0fU) | ((x & 0x0f0f'0f0fU) << 4U);
+      x = ((x >> 8U) & 0x00ff'00ffU) | ((x & 0x00ff'00ffU) << 8U);
+      return (x >> 16U) | (x << 16U);
+    }
+
+    // scrambling de Owen anidado: el hash de Laine-Karras (con las constantes de Burley) solo
+    // propaga bits hacia arriba, así que aplicado a los bits invertidos cada bit depende solo de
+    // los más significativos, que es la condición de una permutación de Owen
+    constexpr std::uint32_t owen_scramble(std::uint32_t x, std::uint32_t seed) {
+      x  = reverse_bits(x);
+      x ^= x * 0x3d20'adeaU;
+      x += seed;
+      x *= (seed >> 16U) | 1U;
+      x ^= x * 0x0552'6c56U;
+      x ^= x * 0x53a2'2864U;
+      return reverse_bits(x);
+    }
+
+    // --- Ruido azul ---
+
+    // desviación del filtro gaussiano con el que se mide la energía (valor de Ulichney)
+    constexpr double VOID_AND_CLUSTER_SIGMA = 1.5;
+
+    // fracción de celdas encendidas en el patrón inicial
+    constexpr std::size_t INITIAL_FRACTION = 10;
+
+    // patrón binario del tile y energía de cada celda: suma del filtro gaussiano (con distancia
+    // toroidal) centrado en cada celda encendida
+    class VoidAndCluster {
+    public:
+      VoidAndCluster()
+          : kernel_(BlueNoiseMask::CELLS), on_(BlueNoiseMask::CELLS, 0),
+            energy_(BlueNoiseMask::CELLS, 0.0) {
+        constexpr int SIZE          = BlueNoiseMask::SIZE;
+        constexpr double TWO_SIGMA2 = 2.0 * VOID_AND_CLUSTER_SIGMA * VOID_AND_CLUSTER_SIGMA;
+        for (int dy = 0; dy < SIZE; ++dy) {
+          for (int dx = 0; dx < SIZE; ++dx) {
+            int const wx          = std::min(dx, SIZE - dx);
+            int const wy          = std::min(dy, SIZE - dy);
+            double const d2       = static_cast<double>(wx * wx + wy * wy);
+            kernel_[cell(dx, dy)] = std::exp(-d2 / TWO_SIGMA2);
+          }
+        }
+      }
+
+      void set(std::size_t c, bool on) {
+        constexpr int SIZE = BlueNoiseMask::SIZE;
+        on_[c]             = on ? 1 : 0;
+        double const sign  = on ? 1.0 : -1.0;
+        int const cx       = static_cast<int>(c % BlueNoiseMask::SIZE);
+        int const cy       = static_cast<int>(c / BlueNoiseMask::SIZE);
+        for (int y = 0; y < SIZE; ++y) {
+          for (int x = 0; x < SIZE; ++x) {
+            energy_[cell(x, y)] += sign * kernel_[cell(x - cx + SIZE, y - cy + SIZE)];
+          }
+        }
+      }
+
+      [[nodiscard]] bool is_on(std::size_t c) const { return on_[c] != 0; }
+
+      // celda encendida con más energía (el grupo más apretado)
+      [[nodiscard]] std::size_t tightest_cluster() const { return extreme(1, std::greater{}); }
+
+      // celda apagada con menos energía (el hueco más grande)
+      [[nodiscard]] std::size_t largest_void() const { return extreme(0, std::less{}); }
+
+    private:
+      static std::size_t cell(int x, int y) {
+        constexpr int MASK = BlueNoiseMask::SIZE - 1;
+        return static_cast<std::size_t>(y & MASK) * BlueNoiseMask::SIZE +
+               static_cast<std::size_t>(x & MASK);
+      }
+
+      template <typename Better>
+      [[nodiscard]] std::size_t extreme(std::uint8_t state, Better better) const {
+        std::size_t best = BlueNoiseMask::CELLS;
+        for (std::size_t c = 0; c < BlueNoiseMask::CELLS; ++c) {
+          bool const first = best == BlueNoiseMask::CELLS;
+          if (on_[c] == state and (first or better(energy_[c], energy_[best]))) {
+            best = c;
+          }
+        }
+        return best;
+      }
+
+      std::vector<double> kernel_;
+      std::vector<std::uint8_t> on_;
+      std::vector<double> energy_;
+    };
+
+    // patrón inicial: una de cada INITIAL_FRACTION celdas encendida al azar y relajado moviendo
+    // el punto del grupo más apretado al hueco más grande hasta que el hueco es el propio punto
+    VoidAndCluster initial_pattern(std::size_t ones) {
+      VoidAndCluster pattern;
+      for (std::uint64_t i = 0, placed = 0; placed < ones; ++i) {
+        std::size_t const c = mix64(i) % BlueNoiseMask::CELLS;
+        if (!pattern.is_on(c)) {
+          pattern.set(c, true);
+          ++placed;
+        }
+      }
+      for (std::size_t step = 0; step < BlueNoiseMask::CELLS; ++step) {
+        std::size_t const cluster = pattern.tightest_cluster();
+        pattern.set(cluster, false);
+        std::size_t const hole = pattern.largest_void();
+        pattern.set(hole, true);
+        if (hole == cluster) {
+          break;
+        }
+      }
+      return pattern;
+    }
+
+  }  // namespace
+
+  char const * sampler_name(SamplerType type) {
+    switch (type) {
+      case SamplerType::HALTON:     return "halton";
+      case SamplerType::SOBOL:      return "sobol";
+      case SamplerType::BLUE_NOISE: return "bluenoise";
+      case SamplerType::RANDOM:     break;
+    }
+    return "random";
+  }
+
+  std::optional<SamplerType> parse_sampler_type(std::string_view name) {
+    for (SamplerType const type : {SamplerType::RANDOM, SamplerType::HALTON, SamplerType::SOBOL,
+                                   SamplerType::BLUE_NOISE})
+    {
+      if (name == sampler_name(type)) {
+        return type;
+      }
+    }
+    return std::nullopt;
+  }
+
+  direction_vector random_vec(SampleStream & samples, double min, double max) {
+    return {samples.next(min, max), samples.next(min, max), samples.next(min, max)};
+  }
+
+  Sampler::Sampler(SamplerType type, std::uint64_t seed) : type_(type), seed_(seed) {
+    if (type_ == SamplerType::BLUE_NOISE) {
+      mask_ = &BlueNoiseMask::instance();
+    }
+  }
+
+  std::uint64_t Sampler::pixel_seed(SamplePoint const & point) const {
+    return hash(seed_, pixel_key(point));
+  }
+
+  double Sampler::get(SamplePoint const & point, std::uint64_t pixel_seed,
+                      std::uint32_t dimension) const {
+    switch (type_) {
+      case SamplerType::HALTON:     return halton(point, pixel_seed, dimension);
+      case SamplerType::SOBOL:      return sobol(point, pixel_seed, dimension);
+      case SamplerType::BLUE_NOISE: return blue_noise(point, dimension);
+      case SamplerType::RANDOM:     break;
+    }
+    std::uint64_t const h = hash(hash(pixel_seed, point.index), dimension);
+    return static_cast<double>(h >> 11U) * 0x1p-53;
+  }
+
+  // las dimensiones a partir de la 32 reutilizan las bases con otra semilla de desplazamiento
+  double Sampler::halton(SamplePoint const & point, std::uint64_t pixel_seed,
+                         std::uint32_t dimension) const {
+    std::uint32_t const base = PRIMES[dimension % PRIMES.size()];
+    return scrambled_radical_inverse(point.index, base, hash(pixel_seed, dimension));
+  }
+
+  double Sampler::sobol(SamplePoint const & point, std::uint64_t pixel_seed,
+                        std::uint32_t dimension) const {
+    std::uint64_t const group_seed = hash(pixel_seed, dimension / SOBOL_GROUP);
+    auto const shuffle_seed        = static_cast<std::uint32_t>(group_seed);
+    auto const scramble_seed       = static_cast<std::uint32_t>(hash(group_seed, dimension));
+    std::uint32_t const index      = owen_scramble(point.index, shuffle_seed);
+    std::uint32_t const value      = sobol_sample(index, dimension % SOBOL_GROUP);
+    return static_cast<double>(owen_scramble(value, scramble_seed)) * INV_2_POW_32;
+  }
+
+  double Sampler::blue_noise(SamplePoint const & point, std::uint32_t dimension) const {
+    constexpr auto SIZE_MASK = static_cast<std::uint64_t>(BlueNoiseMask::SIZE - 1);
+    std::uint64_t const h    = hash(seed_, dimension);
+    auto const offset_x      = static_cast<int>(h & SIZE_MASK);
+    auto const offset_y      = static_cast<int>((h >> 8U) & SIZE_MASK);
+    double const rotation    = static_cast<double>(h >> 32U) * INV_2_POW_32;
+    double const rank        = mask_->rank(point.x + offset_x, point.y + offset_y);
+    double const threshold   = (rank + 0.5) / static_cast<double>(BlueNoiseMask::CELLS);
+    double const value       = threshold + rotation +
+                         GOLDEN_RATIO_CONJUGATE * static_cast<double>(point.index);
+    return std::min(value - std::floor(value), ONE_MINUS_EPSILON);
+  }
+
+  BlueNoiseMask const & BlueNoiseMask::instance() {
+    static BlueNoiseMask const mask;
+    return mask;
+  }
+
+  // rangos: los puntos del patrón inicial se numeran hacia abajo quitando cada vez el grupo más
+  // apretado, y el resto hacia arriba rellenando cada vez el hueco más grande (pasado el 50% eso
+  // equivale a encender el grupo más apretado de celdas apagadas, la tercera fase de Ulichney)
+  BlueNoiseMask::BlueNoiseMask() {
+    ScopedTimer const timer("blue_noise_mask", "setup");
+    std::size_t const ones       = CELLS / INITIAL_FRACTION;
+    VoidAndCluster const initial = initial_pattern(ones);
+
+    VoidAndCluster removing = initial;
+    for (std::size_t rank = ones; rank > 0; --rank) {
+      std::size_t const c = removing.tightest_cluster();
+      removing.set(c, false);
+      ranks_[c] = static_cast<std::uint16_t>(rank - 1);
+    }
+
+    VoidAndCluster adding = initial;
+    for (std::size_t rank = ones; rank < CELLS; ++rank) {
+      std::size_t const c = adding.largest_void();
+      adding.set(c, true);
+      ranks_[c] = static_cast<std::uint16_t>(rank);
+    }
+  }
+
+}  // namespace render
@@ -0,0 +1,196 @@
+#include "../include/scatter_batch.hpp"
+
+#include "../include/material_logic.hpp"
+#include "../include/render_stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+
+namespace render {
+
+  namespace {
+
+    // Los kernels recorren el lote en bloques: escriben en arrays locales, que no pueden solaparse
+    // con las columnas de entrada (así el bucle vectoriza sin comprobar alias en tiempo de
+    // ejecución), y después los copian a las columnas de salida
+    constexpr std::size_t BLOCK_SIZE = 64;
+
+    // umbral de vector::near_zero
+    constexpr double NEAR_ZERO = 1e-8;
+
+    struct DirectionBlock {
+      std::array<double, BLOCK_SIZE> x, y, z;
+      std::array<std::uint8_t, BLOCK_SIZE> bounced;
+
+      void set(std::size_t i, direction_vector const & dir) {
+        x[i] = dir.get_x();
+        y[i] = dir.get_y();
+        z[i] = dir.get_z();
+      }
+
+      void store(std::size_t start, std::size_t count, ScatterBatch & batch) const {
+        std::ranges::copy(std::span(x).first(count), std::span(batch.out_x).subspan(start).begin());
+        std::ranges::copy(std::span(y).first(count), std::span(batch.out_y).subspan(start).begin());
+        std::ranges::copy(std::span(z).first(count), std::span(batch.out_z).subspan(start).begin());
+        std::ranges::copy(std::span(bounced).first(count),
+                          std::span(batch.bounced).subspan(start).begin());
+      }
+    };
+
+    // near_zero sin ramas: todas las componentes son pequeñas si la mayor lo es
+    inline double largest_abs(double x, double y, double z) {
+      return std::max(std::abs(x), std::max(std::abs(y), std::abs(z)));
+    }
+
+  }  // namespace
+
+  ScatterBatch::ScatterBatch(std::size_t capacity)
+      : dir_x(capacity), dir_y(capacity), dir_z(capacity), normal_x(capacity),
+        normal_y(capacity), normal_z(capacity), front_face(capacity),
+        uniforms{std::vector<double>(capacity), std::vector<double>(capacity),
+                 std::vector<double>(capacity)},
+        out_x(capacity), out_y(capacity), out_z(capacity), bounced(capacity) { }
+
+  std::size_t scatter_uniforms(MaterialBase const & mat, MatteScatter matte_scatter) {
+    switch (mat.type) {
+      case MATTE_TYPE: return matte_scatter == MatteScatter::COSINE ? 2 : 3;
+      case METAL_TYPE: return 3;
+      case REFRACTIVE_TYPE: return 0;
+    }
+    return 0;
+  }
+
+  // normal + offset uniforme en [-1, 1]^3, normalizada (la normal si la suma es casi nula)
+  color_vector scatter_matte_batch(MatteMaterial const & mat, MatteScatter matte_scatter,
+                                   ScatterBatch & batch) {
+    auto const & u = batch.uniforms;
+    for (std::size_t start = 0; start < batch.size; start += BLOCK_SIZE) {
+      std::size_t const count = std::min(BLOCK_SIZE, batch.size - start);
+      DirectionBlock block{};
+      if (matte_scatter == MatteScatter::COSINE) {
+        for (std::size_t i = 0; i < count; ++i) {
+          std::size_t const k = start + i;
+          normal_vector const normal(batch.normal_x[k], batch.normal_y[k], batch.normal_z[k]);
+          block.set(i, cosine_hemisphere(normal, u[0][k], u[1][k]));
+        }
+      } else {
+        for (std::size_t i = 0; i < count; ++i) {
+          std::size_t const k = start + i;
+          double const x      = batch.normal_x[k] + (-1.0 + 2.0 * u[0][k]);
+          double const y      = batch.normal_y[k] + (-1.0 + 2.0 * u[1][k]);
+          double const z      = batch.normal_z[k] + (-1.0 + 2.0 * u[2][k]);
+          double const inv    = 1.0 / std::sqrt(x * x + y * y + z * z);
+          bool const near     = largest_abs(x, y, z) < NEAR_ZERO;
+          block.x[i]          = near ? batch.normal_x[k] : inv * x;
+          block.y[i]          = near ? batch.normal_y[k] : inv * y;
+          block.z[i]          = near ? batch.normal_z[k] : inv * z;
+        }
+      }
+      block.bounced.fill(1);
+      block.store(start, count, batch);
+    }
+    return {mat.reflectance_r, mat.reflectance_g, mat.reflectance_b};
+  }
+
+  // reflexión especular más un offset uniforme en [-diffusion, diffusion]^3; se absorbe si la
+  // dirección resultante entra en la superficie
+  color_vector scatter_metal_batch(MetalMaterial const & mat, ScatterBatch & batch) {
+    auto const & u     = batch.uniforms;
+    double const min   = -mat.diffusion;
+    double const range = mat.diffusion - min;
+    for (std::size_t start = 0; start < batch.size; start += BLOCK_SIZE) {
+      std::size_t const count = std::min(BLOCK_SIZE, batch.size - start);
+      DirectionBlock block{};
+      for (std::size_t i = 0; i < count; ++i) {
+        std::size_t const k = start + i;
+        double const nx     = batch.normal_x[k];
+        double const ny     = batch.normal_y[k];
+        double const nz     = batch.normal_z[k];
+        double const inv    = 1.0 / std::sqrt(batch.dir_x[k] * batch.dir_x[k] +
+                                           batch.dir_y[k] * batch.dir_y[k] +
+                                           batch.dir_z[k] * batch.dir_z[k]);
+        double const ux     = inv * batch.dir_x[k];
+        double const uy     = inv * batch.dir_y[k];
+        double const uz     = inv * batch.dir_z[k];
+        double const s      = 2.0 * (ux * nx + uy * ny + uz * nz);
+        double const x      = (ux - s * nx) + (min + range * u[0][k]);
+        double const y      = (uy - s * ny) + (min + range * u[1][k]);
+        double const z      = (uz - s * nz) + (min + range * u[2][k]);
+        double const len    = 1.0 / std::sqrt(x * x + y * y + z * z);
+        block.x[i]          = len * x;
+        block.y[i]          = len * y;
+        block.z[i]          = len * z;
+      }
+      // en un bucle aparte: mezclar la columna de bytes con las de double impide vectorizar
+      for (std::size_t i = 0; i < count; ++i) {
+        std::size_t const k = start + i;
+        double const cos_n  = block.x[i] * batch.normal_x[k] + block.y[i] * batch.normal_y[k] +
+                             block.z[i] * batch.normal_z[k];
+        block.bounced[i]    = cos_n > 0.0 ? 1 : 0;
+      }
+      block.store(start, count, batch);
+    }
+    return {mat.reflectance_r, mat.reflectance_g, mat.reflectance_b};
+  }
+
+  // refracción de Snell o reflexión total; las dos direcciones se calculan y se elige una
+  color_vector scatter_refractive_batch(RefractiveMaterial const & mat, ScatterBatch & batch) {
+    double const ir = mat.refractive_index;
+    for (std::size_t start = 0; start < batch.size; start += BLOCK_SIZE) {
+      std::size_t const count = std::min(BLOCK_SIZE, batch.size - start);
+      DirectionBlock block{};
+      for (std::size_t i = 0; i < count; ++i) {
+        std::size_t const k = start + i;
+        double const nx     = batch.normal_x[k];
+        double const ny     = batch.normal_y[k];
+        double const nz     = batch.normal_z[k];
+        double const ratio  = batch.front_face[k] != 0 ? (1.0 / ir) : ir;
+        double const inv    = 1.0 / std::sqrt(batch.dir_x[k] * batch.dir_x[k] +
+                                           batch.dir_y[k] * batch.dir_y[k] +
+                                           batch.dir_z[k] * batch.dir_z[k]);
+        double const ux     = inv * batch.dir_x[k];
+        double const uy     = inv * batch.dir_y[k];
+        double const uz     = inv * batch.dir_z[k];
+        double const cos_t  = std::min(-ux * nx + -uy * ny + -uz * nz, 1.0);
+        double const sin_t  = std::sqrt(1.0 - cos_t * cos_t);
+        bool const reflect  = ratio * sin_t > 1.0;
+        double const s      = 2.0 * (ux * nx + uy * ny + uz * nz);
+        double const px     = ratio * (ux + cos_t * nx);
+        double const py     = ratio * (uy + cos_t * ny);
+        double const pz     = ratio * (uz + cos_t * nz);
+        double const par    = -std::sqrt(std::abs(1.0 - (px * px + py * py + pz * pz)));
+        block.x[i]          = reflect ? ux - s * nx : px + par * nx;
+        block.y[i]          = reflect ? uy - s * ny : py + par * ny;
+        block.z[i]          = reflect ? uz - s * nz : pz + par * nz;
+      }
+      block.bounced.fill(1);
+      block.store(start, count, batch);
+    }
+    return {1.0, 1.0, 1.0};
+  }
+
+  color_vector scatter_batch(MaterialBase const & mat, MatteScatter matte_scatter,
+                             ScatterBatch & batch) {
+    color_vector attenuation;
+    switch (mat.type) {
+      case MATTE_TYPE:
+        attenuation = scatter_matte_batch(static_cast<MatteMaterial const &>(mat), matte_scatter,
+                                          batch);
+        break;
+      case METAL_TYPE:
+        attenuation = scatter_metal_batch(static_cast<MetalMaterial const &>(mat), batch);
+        break;
+      case REFRACTIVE_TYPE:
+        attenuation =
+            scatter_refractive_batch(static_cast<RefractiveMaterial const &>(mat), batch);
+        break;
+    }
+    for (std::size_t k = 0; k < batch.size; ++k) {
+      RENDER_STAT(thread_stats().count_scatter(mat.type, batch.bounced[k] != 0));
+    }
+    return attenuation;
+  }
+
+}  // namespace render
@@ -2,11 +2,13 @@
 /**/
 #include "../include/scene_parser.hpp"
 #include "../include/parser_utilities.hpp"
+#include "../include/trace.hpp"
 #include "materials.hpp"
 #include "objects.hpp"
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -20,6 +22,7 @@ namespace {
     std::vector<Sphere> * spheres;
     std::vector<Cylinder> * cylinders;
     std::unordered_set<std::string> * material_names;
+    int line_number = 0;  // línea que se está parseando (se guarda en cada objeto)
   };
 
   // Helper para matte - SIN código duplicado
@@ -153,6 +156,7 @@ namespace {
     s.center_z      = z;
     s.radius        = radius;
     s.material_name = material;
+    s.source_line   = data.line_number;
 
     // SOLO una línea - sin duplicado
     data.spheres->push_back(s);
@@ -194,6 +198,7 @@ namespace {
     c.axis_y        = ay;
     c.axis_z        = az;
     c.material_name = material;
+    c.source_line   = data.line_number;
 
     // SOLO una línea - sin duplicado
     data.cylinders->push_back(c);
@@ -275,6 +280,7 @@ namespace {
 
     std::string line;
     while (std::getline(file, line)) {
+      ++data.line_number;
       if (is_empty_line(line)) {
         continue;
       }
@@ -307,6 +313,7 @@ namespace {
 }  // namespace
 
 bool parse_scene(std::string const & filename, SceneOutput & out) {
+  render::ScopedTimer const timer("parse_scene", "setup");
   std::unordered_set<std::string> material_names;
 
   SceneData data{
@@ -320,3 +327,39 @@ bool parse_scene(std::string const & filename, SceneOutput & out) {
 
   return parse_scene_impl(filename, data);
 }
+
+bool link_materials(SceneOutput & scene) {
+  render::ScopedTimer const timer("link_materials", "setup");
+  // Creamos un mapa para buscar punteros a materiales por su nombre
+  std::unordered_map<std::string, render::MaterialBase const *> material_map;
+
+  for (auto const & mat : scene.matte_materials.get()) {
+    material_map[mat.name] = &mat;
+  }
+  for (auto const & mat : scene.metal_materials.get()) {
+    material_map[mat.name] = &mat;
+  }
+  for (auto const & mat : scene.refractive_materials.get()) {
+    material_map[mat.name] = &mat;
+  }
+
+  // Asignamos los punteros de material a los objetos
+  for (auto & sph : scene.spheres.get()) {
+    auto it = material_map.find(sph.material_name);
+    if (it == material_map.end()) {
+      std::cerr << "Error: Material '" << sph.material_name << "' no encontrado para una esfera.\n";
+      return false;
+    }
+    sph.material_ptr = it->second;
+  }
+  for (auto & cyl : scene.cylinders.get()) {
+    auto it = material_map.find(cyl.material_name);
+    if (it == material_map.end()) {
+      std::cerr << "Error: Material '" << cyl.material_name
+                << "' no encontrado para un cilindro.\n";
+      return false;
+    }
+    cyl.material_ptr = it->second;
+  }
+  return true;
+}
@@ -0,0 +1,117 @@
+#include "../include/snapshot_writer.hpp"
+#include "../include/trace.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace render {
+
+  namespace {
+
+    // escribe los píxeles en formato P6 (RGB intercalado, un byte por canal) fila a fila
+    void write_rows(std::ostream & out, AccumulationBuffer const & buffer, GammaLUT const & lut,
+                    bool last_row_first) {
+      auto const width = static_cast<std::size_t>(buffer.width());
+      std::vector<double> r_row(width);
+      std::vector<double> g_row(width);
+      std::vector<double> b_row(width);
+      std::vector<std::uint8_t> channel(width);
+      std::vector<char> bytes(3 * width);
+
+      for (int row = 0; row < buffer.height(); ++row) {
+        int const y = last_row_first ? buffer.height() - 1 - row : row;
+        buffer.row_average(y, r_row, g_row, b_row);
+        std::size_t offset = 0;
+        for (std::vector<double> const * linear : {&r_row, &g_row, &b_row}) {
+          lut.quantize(*linear, channel);
+          for (std::size_t x = 0; x < width; ++x) {
+            bytes[3 * x + offset] = static_cast<char>(channel[x]);
+          }
+          ++offset;
+        }
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+      }
+    }
+
+  }  // namespace
+
+  SnapshotWriter::SnapshotWriter(std::string filename, double gamma, bool last_row_first)
+      : filename_(std::move(filename)), lut_(gamma), last_row_first_(last_row_first),
+        worker_([this] { run(); }) { }
+
+  SnapshotWriter::~SnapshotWriter() {
+    finish();
+  }
+
+  void SnapshotWriter::submit(AccumulationBuffer const & buffer) {
+    {
+      std::lock_guard const lock(mutex_);
+      // la asignación reutiliza la memoria de la copia anterior (mismas dimensiones)
+      pending_     = buffer;
+      has_pending_ = true;
+    }
+    ready_.notify_one();
+  }
+
+  void SnapshotWriter::finish() {
+    {
+      std::lock_guard const lock(mutex_);
+      stopping_ = true;
+    }
+    ready_.notify_one();
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+  }
+
+  void SnapshotWriter::run() {
+    while (true) {
+      {
+        std::unique_lock lock(mutex_);
+        ready_.wait(lock, [this] { return has_pending_ or stopping_; });
+        if (!has_pending_) {
+          return;
+        }
+        // intercambio de buffers: submit() puede seguir copiando mientras se escribe este
+        std::swap(pending_, encoding_);
+        has_pending_ = false;
+      }
+      if (write_snapshot(*encoding_)) {
+        ++written_;
+      }
+    }
+  }
+
+  bool SnapshotWriter::write_snapshot(AccumulationBuffer const & buffer) const {
+    ScopedTimer const timer("write_snapshot", "io");
+    // se escribe en un temporal y se renombra para no dejar nunca una imagen a medias
+    std::string const tmp_filename = filename_ + ".tmp";
+    {
+      std::ofstream out(tmp_filename, std::ios::binary | std::ios::trunc);
+      if (!out.is_open()) {
+        std::cerr << "Error: Cannot create snapshot file " << tmp_filename << '\n';
+        return false;
+      }
+      out << "P6\n" << buffer.width() << ' ' << buffer.height() << "\n255\n";
+      write_rows(out, buffer, lut_, last_row_first_);
+      if (!out.flush()) {
+        std::cerr << "Error: Cannot write snapshot file " << tmp_filename << '\n';
+        return false;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_filename, filename_, ec);
+    if (ec) {
+      std::cerr << "Error: Cannot replace snapshot file " << filename_ << ": " << ec.message()
+                << '\n';
+      return false;
+    }
+    return true;
+  }
+
+}  // namespace render
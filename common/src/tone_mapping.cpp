@@ -0,0 +1,56 @@
+#include "../include/tone_mapping.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace render {
+
+  namespace {
+
+    // tamaño de bloque: los índices de un bloque caben en la pila y el primer bucle vectoriza
+    constexpr std::size_t BLOCK_SIZE = 256;
+
+    // clamp a [0, 1] sin ramas; las comparaciones están escritas para que NaN acabe en 0
+    inline double saturate(double value) {
+      double const positive = value > 0.0 ? value : 0.0;
+      return positive < 1.0 ? positive : 1.0;
+    }
+
+    inline std::int32_t lut_index(double value) {
+      double const scaled = std::sqrt(saturate(value)) * static_cast<double>(GammaLUT::LUT_SIZE);
+      return static_cast<std::int32_t>(scaled + 0.5);
+    }
+
+  }  // namespace
+
+  // la entrada k corresponde a s = k / LUT_SIZE, es decir, al valor lineal x = s^2
+  GammaLUT::GammaLUT(double gamma) : gamma_(gamma) {
+    double const exponent = 2.0 / gamma;
+    for (std::size_t k = 0; k <= LUT_SIZE; ++k) {
+      double const s         = static_cast<double>(k) / static_cast<double>(LUT_SIZE);
+      double const corrected = std::clamp(std::pow(s, exponent), 0.0, 1.0);
+      table_[k]              = static_cast<std::uint8_t>(corrected * 255.0);
+    }
+  }
+
+  std::uint8_t GammaLUT::to_byte(double value) const {
+    return table_[static_cast<std::size_t>(lut_index(value))];
+  }
+
+  // conversión por bloques
+  // primero se calculan todos los índices del bloque (clamp, sqrt, escala y truncado: un bucle
+  // sin dependencias que el compilador vectoriza) y después se leen las entradas de la tabla
+  void GammaLUT::quantize(std::span<double const> linear, std::span<std::uint8_t> out) const {
+    std::array<std::int32_t, BLOCK_SIZE> indices{};
+    for (std::size_t start = 0; start < linear.size(); start += BLOCK_SIZE) {
+      std::size_t const count = std::min(BLOCK_SIZE, linear.size() - start);
+      for (std::size_t i = 0; i < count; ++i) {
+        indices[i] = lut_index(linear[start + i]);
+      }
+      for (std::size_t i = 0; i < count; ++i) {
+        out[start + i] = table_[static_cast<std::size_t>(indices[i])];
+      }
+    }
+  }
+
+}  // namespace render
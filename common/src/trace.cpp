@@ -0,0 +1,138 @@
+#include "../include/trace.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <set>
+
+namespace render {
+
+  namespace {
+
+    double microseconds(TraceRecorder::clock::duration d) {
+      return std::chrono::duration<double, std::micro>(d).count();
+    }
+
+    void write_event(std::ostream & out, TraceRecorder::Event const & event,
+                     TraceRecorder::clock::time_point origin) {
+      out << "  {\"name\": \"" << event.name << "\", \"cat\": \"" << event.category
+          << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event.thread
+          << ", \"ts\": " << microseconds(event.start - origin)
+          << ", \"dur\": " << microseconds(event.end - event.start);
+      if (event.arg) {
+        out << ", \"args\": {\"value\": " << *event.arg << '}';
+      }
+      out << '}';
+    }
+
+  }  // namespace
+
+  TraceRecorder & TraceRecorder::instance() {
+    static TraceRecorder recorder;
+    return recorder;
+  }
+
+  void TraceRecorder::enable() {
+    // el hilo que activa el registro (el principal) queda como hilo 0
+    (void) thread_index();
+    std::lock_guard const lock(mutex_);
+    origin_ = clock::now();
+    enabled_.store(true, std::memory_order_relaxed);
+  }
+
+  void TraceRecorder::record(Event const & event) {
+    std::lock_guard const lock(mutex_);
+    events_.push_back(event);
+  }
+
+  int TraceRecorder::thread_index() {
+    static std::atomic<int> next_index{0};
+    thread_local int const index = next_index.fetch_add(1, std::memory_order_relaxed);
+    return index;
+  }
+
+  bool TraceRecorder::write(std::string const & filename) const {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+      std::cerr << "Error: Cannot create trace file " << filename << '\n';
+      return false;
+    }
+    std::lock_guard const lock(mutex_);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    // nombre de cada pista: el hilo 0 es el principal
+    std::set<int> threads;
+    for (Event const & event : events_) {
+      threads.insert(event.thread);
+    }
+    for (int const thread : threads) {
+      out << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread
+          << ", \"args\": {\"name\": \"" << (thread == 0 ? "main" : "worker ")
+          << (thread == 0 ? "" : std::to_string(thread)) << "\"}},\n";
+    }
+    for (std::size_t i = 0; i < events_.size(); ++i) {
+      write_event(out, events_[i], origin_);
+      out << (i + 1 < events_.size() ? ",\n" : "\n");
+    }
+    out << "]}\n";
+    if (!out) {
+      std::cerr << "Error: Cannot write trace file " << filename << '\n';
+      return false;
+    }
+    return true;
+  }
+
+  ScopedTimer::ScopedTimer(char const * name, char const * category)
+      : trace_active_(TraceRecorder::instance().enabled()),
+        perf_active_(PerfCounters::instance().measures_this_thread()),
+        alloc_active_(AllocationProfile::instance().active()), name_(name), category_(category) {
+    if (alloc_active_) {
+      alloc_start_ = thread_allocations();
+    }
+    if (perf_active_) {
+      perf_start_ = PerfCounters::instance().read();
+    }
+    if (trace_active_ or perf_active_) {
+      start_ = TraceRecorder::clock::now();
+    }
+  }
+
+  ScopedTimer::ScopedTimer(char const * name, char const * category, std::int64_t arg)
+      : ScopedTimer(name, category) {
+    arg_ = arg;
+  }
+
+  ScopedTimer::~ScopedTimer() {
+    if (!trace_active_ and !perf_active_ and !alloc_active_) {
+      return;
+    }
+    auto const end = TraceRecorder::clock::now();
+    // primero las asignaciones: registrar la fase en los perfiles puede asignar memoria (la
+    // primera vez que aparece una fase, o al crecer la traza)
+    AllocationCount const now = thread_allocations();
+    if (alloc_active_) {
+      AllocationProfile::instance().add_phase(
+          name_, category_,
+          {.allocations = now.allocations - alloc_start_.allocations,
+           .bytes       = now.bytes - alloc_start_.bytes});
+    }
+    if (perf_active_) {
+      PerfCounters::Reading delta = PerfCounters::instance().read();
+      for (std::size_t i = 0; i < delta.size(); ++i) {
+        delta[i] -= perf_start_[i];
+      }
+      PerfCounters::instance().add_phase(name_, delta, end - start_);
+    }
+    if (trace_active_) {
+      TraceRecorder::instance().record({.name     = name_,
+                                        .category = category_,
+                                        .start    = start_,
+                                        .end      = end,
+                                        .thread   = TraceRecorder::thread_index(),
+                                        .arg      = arg_});
+    }
+    // y esas asignaciones no cuentan para las fases que contienen a esta
+    if (alloc_active_) {
+      rewind_thread_allocations(now);
+    }
+  }
+
+}  // namespace render
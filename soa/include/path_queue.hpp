@@ -0,0 +1,65 @@
+#ifndef SOA_PATH_QUEUE_HPP
+#define SOA_PATH_QUEUE_HPP
+
+#include "../../common/include/material_base.hpp"
+#include "../../common/include/object_base.hpp"
+#include "../../common/include/scatter_batch.hpp"
+#include "../../common/include/vector.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace soa {
+
+  // COLA DE CAMINOS EN FORMATO SOA
+  // Un camino es una muestra de un píxel que rebota por la escena; ocupa la misma posición k en
+  // todas las columnas. Las etapas recorren las columnas de principio a fin sin recursión.
+  // Las columnas del rayo y del impacto son de render::real (float en modo RENDER_FLOAT: la
+  // mitad de memoria y el doble de carriles en los bucles de intersect)
+  struct PathQueue {
+    explicit PathQueue(std::size_t capacity);
+
+    [[nodiscard]] std::size_t capacity() const { return origin_x.size(); }
+
+    // copia el camino 'from' en la posición 'to' (compactación)
+    void move(std::size_t from, std::size_t to);
+
+    // deja al principio, en el mismo orden, los caminos con alive != 0; size pasa a ser su número
+    void compact();
+
+    // copia en las posiciones 0, 1... los caminos order[0], order[1]... de 'src' (las mismas
+    // columnas que move); size pasa a ser order.size()
+    void gather(PathQueue const & src, std::span<std::uint32_t const> order);
+
+    std::size_t size = 0;
+
+    // rayo actual
+    std::vector<render::real> origin_x, origin_y, origin_z;
+    std::vector<render::real> dir_x, dir_y, dir_z;
+    // producto de las atenuaciones de los rebotes anteriores
+    std::vector<double> weight_r, weight_g, weight_b;
+    // columna del píxel en la fila, índice de la muestra dentro del píxel y siguiente dimensión
+    // del sampler
+    std::vector<std::uint32_t> pixel, sample, dimension;
+    // rebotes hechos
+    std::vector<int> depth;
+
+    // resultado de intersect: distancia, normal exterior, objeto y su material (nullptr = fondo)
+    std::vector<render::real> hit_t;
+    std::vector<render::real> normal_x, normal_y, normal_z;
+    std::vector<render::ObjectBase const *> hit_object;
+    std::vector<render::MaterialBase const *> hit_material;
+    // números uniformes de la dispersión, sacados por shade en el orden de la cola antes de
+    // agrupar los impactos por material (ni move ni gather los copian)
+    std::array<std::vector<double>, render::MAX_SCATTER_UNIFORMS> uniforms;
+
+    // el camino sigue tras shade
+    std::vector<std::uint8_t> alive;
+  };
+
+}  // namespace soa
+
+#endif  // SOA_PATH_QUEUE_HPP
@@ -0,0 +1,201 @@
+#ifndef SOA_RAY_PACKET_HPP
+#define SOA_RAY_PACKET_HPP
+
+#include "../../common/include/objects.hpp"
+#include "../../common/include/render_stats.hpp"
+#include "../../common/include/scene_parser.hpp"
+#include "../../common/include/vector.hpp"
+#include "path_queue.hpp"
+#include "soa_ray.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+// Ancho de los paquetes de rayos primarios (opción SOA_PACKET_WIDTH de CMake: 1, 4, 8 o 16;
+// 1 desactiva los paquetes)
+#ifndef SOA_PACKET_WIDTH
+  #define SOA_PACKET_WIDTH 8
+#endif
+
+namespace soa {
+
+  constexpr std::size_t PACKET_WIDTH = SOA_PACKET_WIDTH;
+  static_assert(PACKET_WIDTH == 1 or PACKET_WIDTH == 4 or PACKET_WIDTH == 8 or
+                    PACKET_WIDTH == 16,
+                "SOA_PACKET_WIDTH debe ser 1, 4, 8 o 16");
+
+  // PAQUETES DE RAYOS PRIMARIOS
+  // Un paquete son N caminos consecutivos de la cola con el mismo origen (la cámara) y
+  // direcciones cercanas. Antes de probar un objeto con los N rayos se prueba una sola vez el
+  // cono que los contiene contra la esfera envolvente del objeto: si el cono no la toca (o toda
+  // ella está más lejos que los impactos del paquete) el objeto se descarta para los N. Los que
+  // quedan se prueban con bucles de N carriles sin saltos (vectorizables), con máscara de
+  // impacto por carril. Con orígenes distintos o un cono demasiado abierto el paquete diverge y
+  // se traza rayo a rayo
+
+  // Esfera que contiene un objeto
+  struct BoundingSphere {
+    render::vector center;
+    double radius{};
+  };
+
+  // Cono con vértice en el origen común del paquete y eje unitario que contiene todas sus
+  // direcciones
+  struct PacketCone {
+    render::vector apex;
+    render::vector axis;
+    double cos_half{};
+    double sin_half{};
+  };
+
+  // coseno mínimo del semiángulo del cono: con uno más abierto el descarte compartido casi nunca
+  // acierta y el paquete se traza rayo a rayo
+  constexpr double PACKET_MIN_COS = 0.95;
+
+  [[nodiscard]] BoundingSphere bounding_sphere(Sphere const & sph);
+  [[nodiscard]] BoundingSphere bounding_sphere(Cylinder const & cyl);
+
+  // parámetros de ray::hit_cylinder para un cilindro de la escena
+  [[nodiscard]] ray::CylinderParams cylinder_params(Cylinder const & cyl);
+
+  // true si ningún rayo del cono puede tocar la esfera a una distancia menor que max_t
+  [[nodiscard]] bool cone_misses(PacketCone const & cone, BoundingSphere const & bound,
+                                 double max_t);
+
+  // prueba el camino k de la cola contra el cilindro y guarda el impacto si es el más cercano
+  void intersect_cylinder_lane(PathQueue & q, std::size_t k, Cylinder const & cyl,
+                               ray::CylinderParams const & params);
+
+  // Cono del paquete que empieza en 'begin'; nullopt si diverge
+  template <std::size_t N>
+  [[nodiscard]] std::optional<PacketCone> packet_cone(PathQueue const & q, std::size_t begin) {
+    render::vector sum{0.0, 0.0, 0.0};
+    for (std::size_t k = begin; k < begin + N; ++k) {
+      if (q.origin_x[k] != q.origin_x[begin] or q.origin_y[k] != q.origin_y[begin] or
+          q.origin_z[k] != q.origin_z[begin])
+      {
+        return std::nullopt;
+      }
+      sum = sum + render::unit_vector(render::vector{q.dir_x[k], q.dir_y[k], q.dir_z[k]});
+    }
+    render::vector const axis = render::unit_vector(sum);
+    double cos_half           = 1.0;
+    for (std::size_t k = begin; k < begin + N; ++k) {
+      render::vector const dir{q.dir_x[k], q.dir_y[k], q.dir_z[k]};
+      cos_half = std::min(cos_half, render::dot(axis, dir) / dir.magnitude());
+    }
+    if (cos_half < PACKET_MIN_COS) {
+      return std::nullopt;
+    }
+    return PacketCone{
+      .apex     = render::vector{q.origin_x[begin], q.origin_y[begin], q.origin_z[begin]},
+      .axis     = axis,
+      .cos_half = cos_half,
+      .sin_half = std::sqrt(1.0 - cos_half * cos_half),
+    };
+  }
+
+  // mayor distancia de impacto del paquete (infinito si algún carril aún no ha impactado)
+  template <std::size_t N>
+  [[nodiscard]] double packet_max_t(PathQueue const & q, std::size_t begin) {
+    double max_t = 0.0;
+    for (std::size_t k = begin; k < begin + N; ++k) {
+      max_t = std::max(max_t, static_cast<double>(q.hit_t[k]));
+    }
+    return max_t;
+  }
+
+  // Esfera contra los N carriles del paquete: la misma ecuación que el bucle rayo a rayo (mismo
+  // resultado bit a bit), con el término c común a todos los carriles y selección en lugar de
+  // saltos. Se calcula en el escalar de la cola (render::real)
+  template <std::size_t N>
+  void intersect_sphere_packet(PathQueue & q, std::size_t begin, Sphere const & sph) {
+    using render::real;
+    real const radius = static_cast<real>(sph.radius);
+    real const ocx    = q.origin_x[begin] - static_cast<real>(sph.center_x);
+    real const ocy    = q.origin_y[begin] - static_cast<real>(sph.center_y);
+    real const ocz    = q.origin_z[begin] - static_cast<real>(sph.center_z);
+    real const c      = ocx * ocx + ocy * ocy + ocz * ocz - radius * radius;
+    std::array<std::uint8_t, N> hit{};
+    for (std::size_t l = 0; l < N; ++l) {
+      std::size_t const k  = begin + l;
+      real const a         = q.dir_x[k] * q.dir_x[k] + q.dir_y[k] * q.dir_y[k] +
+                     q.dir_z[k] * q.dir_z[k];
+      real const half_b    = ocx * q.dir_x[k] + ocy * q.dir_y[k] + ocz * q.dir_z[k];
+      real const disc      = half_b * half_b - a * c;
+      real const sqrt_disc = std::sqrt(std::max(disc, real{0}));
+      real const near      = (-half_b - sqrt_disc) / a;
+      real const root      = near > ray::MIN_DISTANCE_REAL ? near : (-half_b + sqrt_disc) / a;
+      bool const lane_hit  = disc >= 0 and root > ray::MIN_DISTANCE_REAL and root < q.hit_t[k];
+      q.hit_t[k]           = lane_hit ? root : q.hit_t[k];
+      q.hit_object[k]      = lane_hit ? &sph : q.hit_object[k];
+      q.hit_material[k]    = lane_hit ? sph.material_ptr : q.hit_material[k];
+      q.normal_x[k]        = lane_hit ? (ocx + root * q.dir_x[k]) / radius : q.normal_x[k];
+      q.normal_y[k]        = lane_hit ? (ocy + root * q.dir_y[k]) / radius : q.normal_y[k];
+      q.normal_z[k]        = lane_hit ? (ocz + root * q.dir_z[k]) / radius : q.normal_z[k];
+      hit[l]               = lane_hit ? 1 : 0;
+    }
+    for (std::size_t l = 0; l < N; ++l) {
+      RENDER_STAT(render::thread_stats().count_intersection(render::SPHERE_TYPE, hit[l] != 0));
+      RENDER_STAT(render::thread_stats().count_object(sph.source_line, hit[l] != 0));
+    }
+  }
+
+  // Cilindro contra los N carriles: una prueba vectorizable con su esfera envolvente marca los
+  // carriles que pueden impactar antes de su impacto actual, y solo esos llaman a hit_cylinder
+  template <std::size_t N>
+  void intersect_cylinder_packet(PathQueue & q, std::size_t begin, Cylinder const & cyl,
+                                 BoundingSphere const & bound) {
+    double const ocx = q.origin_x[begin] - bound.center.get_x();
+    double const ocy = q.origin_y[begin] - bound.center.get_y();
+    double const ocz = q.origin_z[begin] - bound.center.get_z();
+    double const c   = ocx * ocx + ocy * ocy + ocz * ocz - bound.radius * bound.radius;
+    std::array<std::uint8_t, N> candidate{};
+    for (std::size_t l = 0; l < N; ++l) {
+      std::size_t const k    = begin + l;
+      double const a         = q.dir_x[k] * q.dir_x[k] + q.dir_y[k] * q.dir_y[k] +
+                       q.dir_z[k] * q.dir_z[k];
+      double const half_b    = ocx * q.dir_x[k] + ocy * q.dir_y[k] + ocz * q.dir_z[k];
+      double const disc      = half_b * half_b - a * c;
+      double const sqrt_disc = std::sqrt(std::max(disc, 0.0));
+      bool const inside      = disc >= 0.0 and (-half_b + sqrt_disc) / a >= ray::MIN_DISTANCE and
+                          (-half_b - sqrt_disc) / a <= q.hit_t[k];
+      candidate[l] = inside ? 1 : 0;
+    }
+    ray::CylinderParams const params = cylinder_params(cyl);
+    for (std::size_t l = 0; l < N; ++l) {
+      if (candidate[l] != 0) {
+        intersect_cylinder_lane(q, begin + l, cyl, params);
+      }
+    }
+  }
+
+  // Todos los objetos de la escena contra el paquete que empieza en 'begin'; false si diverge
+  // (no se ha probado nada y hay que trazarlo rayo a rayo)
+  template <std::size_t N>
+  bool intersect_packet(PathQueue & q, std::size_t begin, SceneOutput const & scene) {
+    std::optional<PacketCone> const cone = packet_cone<N>(q, begin);
+    if (!cone) {
+      return false;
+    }
+    for (Sphere const & sph : scene.spheres.get()) {
+      if (!cone_misses(*cone, bounding_sphere(sph), packet_max_t<N>(q, begin))) {
+        intersect_sphere_packet<N>(q, begin, sph);
+      }
+    }
+    for (Cylinder const & cyl : scene.cylinders.get()) {
+      BoundingSphere const bound = bounding_sphere(cyl);
+      if (!cone_misses(*cone, bound, packet_max_t<N>(q, begin))) {
+        intersect_cylinder_packet<N>(q, begin, cyl, bound);
+      }
+    }
+    return true;
+  }
+
+}  // namespace soa
+
+#endif  // SOA_RAY_PACKET_HPP
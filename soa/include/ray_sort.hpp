@@ -0,0 +1,76 @@
+#ifndef SOA_RAY_SORT_HPP
+#define SOA_RAY_SORT_HPP
+
+#include "../../common/include/material_base.hpp"
+#include "../../common/include/scene_parser.hpp"
+#include "../../common/include/vector.hpp"
+#include "path_queue.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Reordenación de la cola de caminos antes de intersect (opción SOA_SORT_RAYS de CMake,
+// desactivada por defecto: sin BVH cada rayo prueba todos los objetos y ordenar cuesta lo que
+// ahorra). La agrupación por material de shade no depende de la opción
+#ifndef SOA_SORT_RAYS
+  #define SOA_SORT_RAYS 0
+#endif
+
+namespace soa {
+
+  constexpr bool SORT_RAYS = SOA_SORT_RAYS != 0;
+
+  // Caja alineada con los ejes que contiene la escena y la cámara
+  struct SceneBox {
+    render::vector min;
+    render::vector max;
+  };
+
+  [[nodiscard]] SceneBox scene_box(SceneOutput const & scene, render::vector const & camera);
+
+  // Clave para intersect: octante de la dirección en los 3 bits altos y código Morton de 15 bits
+  // (5 por eje) del origen cuantizado en la caja
+  [[nodiscard]] std::uint32_t direction_origin_key(render::vector const & origin,
+                                                   render::vector const & dir,
+                                                   SceneBox const & box);
+
+  // Clave para shade: 0 para los caminos que van al fondo; si no, el tipo de material en los
+  // bits altos y la posición del material en su vector de la escena en los bajos
+  [[nodiscard]] std::uint32_t material_key(render::MaterialBase const * mat,
+                                           SceneOutput const & scene);
+
+  // ORDENACIÓN DE CAMINOS ENTRE REBOTES
+  // Tras el primer rebote las direcciones son aleatorias y caminos vecinos en la cola no tienen
+  // nada en común. Antes de intersect se agrupan por octante y posición del origen (rayos que
+  // recorren la escena en el mismo sentido desde la misma zona): las columnas del camino se
+  // mueven de una vez a una cola auxiliar que se intercambia con la original. En shade se
+  // agrupan por material, sin mover nada, para dispersar cada grupo con un kernel por lotes
+  // (scatter_batch.hpp): shade recorre la cola en el orden devuelto. La ordenación es radix estable
+  // de 9 bits sobre las claves y se salta los dígitos comunes a toda la cola. Los buffers se
+  // reservan al construir: ordenar no asigna memoria
+  class RaySorter {
+  public:
+    RaySorter(SceneOutput const & scene, render::vector const & camera, std::size_t capacity);
+
+    void sort_for_intersect(PathQueue & q);
+
+    // posiciones de la cola agrupadas por material; vacío si todas comparten material (el orden
+    // de la cola ya sirve). Válido hasta la siguiente llamada
+    [[nodiscard]] std::span<std::uint32_t const> bin_by_material(PathQueue const & q);
+
+  private:
+    // ordena order_ (las posiciones 0..n-1) según keys_; false si todas las claves son iguales
+    bool sort_keys(std::size_t n);
+
+    SceneOutput const & scene_;
+    SceneBox box_;
+    std::vector<std::uint32_t> keys_, keys_tmp_;
+    std::vector<std::uint32_t> order_, order_tmp_;
+    PathQueue scratch_;
+  };
+
+}  // namespace soa
+
+#endif  // SOA_RAY_SORT_HPP
@@ -2,20 +2,41 @@
 #define SOA_RENDER_SOA_HPP
 
 #include "../../common/include/config.hpp"
+#include "../../common/include/cost_map.hpp"
+#include "../../common/include/progress_reporter.hpp"
+#include "../../common/include/renderer.hpp"
 #include "../../common/include/scene_parser.hpp"
 #include "soa_camera.hpp"
 #include "soa_image.hpp"
 
+#include <cstdint>
+
 namespace soa {
 
-  // Renderiza la escena en la imagen usando la cámara en formato SOA.
-  // Contrato mínimo:
-  // - Usa cfg para dimensiones, SPP y colores de fondo.
-  // - Usa camera.generate_primary_rays para obtener rayos primarios (w*h*spp).
-  // - Si hay intersección con esferas/cilindros, pinta por la normal; si no, color de fondo.
-  // - Escribe el color en SOAImage con corrección gamma.
-  void render_scene(ConfigParams const & cfg, SceneOutput const & scene, CameraSOA & camera,
-                    SOAImage & image);
+  // Destinos del render: la imagen y, opcionalmente, el coste de cada píxel (--heatmap) y el
+  // indicador de progreso (una unidad por fila)
+  struct RenderTarget {
+    SOAImage & image;
+    render::CostMap * cost_map          = nullptr;
+    render::ProgressReporter * progress = nullptr;
+  };
+
+  // Renderiza la escena en la imagen con el trazador de caminos por olas (wavefront.hpp).
+  // - Usa cfg para dimensiones, SPP (o muestreo adaptativo), rebotes, semillas, sampler y fondo.
+  // - Los objetos de la escena deben tener enlazado su material (link_materials).
+  // - Cada fila es una ola: sus caminos rebotan con render::scatter hasta salir al fondo, ser
+  //   absorbidos o llegar a maxdepth.
+  // - Escribe el color en target.image con corrección gamma (y el coste en target.cost_map).
+  // Devuelve el número de rayos primarios trazados (menos de w*h*spp en modo adaptativo).
+  std::uint64_t render_scene(ConfigParams const & cfg, SceneOutput const & scene,
+                             CameraSOA const & camera, RenderTarget const & target);
+
+  // Backend SOA: render completo con render_scene. No admite --resume, --progressive ni
+  // --time-budget (avisa y hace el render completo)
+  class SOARenderer : public render::Renderer {
+  public:
+    bool render(render::RenderJob const & job, std::uint64_t & primary_rays) override;
+  };
 
 }  // namespace soa
 
@@ -2,18 +2,33 @@
 #define SOA_CAMERA_HPP
 
 #include "../../common/include/config.hpp"
+#include "../../common/include/vector.hpp"
 #include <cstddef>
 #include <vector>
 
 namespace soa {
 
-  class CameraSOA {
+  // Plano de la imagen para una resolución: el punto de coordenadas continuas (px, py) de la
+  // imagen, con (0, 0) en la esquina de la fila 0 y px, py en píxeles, está en
+  // corner + px * step_x + py * step_y
+  struct Viewport {
+    render::vector origin;
+    render::vector corner;
+    render::vector step_x;
+    render::vector step_y;
+  };
+
+  // Cámara con las columnas de rayos primarios de tipo T; la base y el plano de la imagen se
+  // calculan siempre en double y cada rayo se redondea a T al guardarlo
+  template <typename T>
+  class BasicCameraSOA {
   public:
-    explicit CameraSOA(ConfigParams const & cfg);
+    explicit BasicCameraSOA(ConfigParams const & cfg);
+    [[nodiscard]] Viewport viewport(std::size_t w, std::size_t h) const;
     void generate_primary_rays(std::size_t w, std::size_t h, std::size_t spp);
 
-    std::vector<double> origins_x, origins_y, origins_z;
-    std::vector<double> dirs_x, dirs_y, dirs_z;
+    std::vector<T> origins_x, origins_y, origins_z;
+    std::vector<T> dirs_x, dirs_y, dirs_z;
 
   private:
     double OX{}, OY{}, OZ{};
@@ -23,6 +38,13 @@ namespace soa {
     double DF{}, FOV{};
   };
 
+  // instanciadas en soa_camera.cpp
+  extern template class BasicCameraSOA<double>;
+  extern template class BasicCameraSOA<float>;
+
+  // cámara con el escalar de la cola de caminos (float en modo RENDER_FLOAT)
+  using CameraSOA = BasicCameraSOA<render::real>;
+
 }  // namespace soa
 
 #endif
@@ -1,6 +1,7 @@
 #ifndef SOA_IMAGE_HPP
 #define SOA_IMAGE_HPP
 
+#include "../../common/include/tone_mapping.hpp"
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -21,8 +22,11 @@ public:
 
   // Establecemos el color de un píxel con corrección gamma
   void setPixel(int row, int col, RGBColor const & color, double gamma);
-  // Escribimos la imagen en un archivo PPM
-  void write_ppm(std::string const & filename) const;
+  // Establecemos una fila completa a partir de sus canales lineales (tabla gamma, sin std::pow)
+  void set_row(int row, render::LinearRow const & linear, render::GammaLUT const & lut);
+  // Escribimos la imagen en un archivo PPM; false (con el error en std::cerr) si no se puede
+  // crear o escribir
+  [[nodiscard]] bool write_ppm(std::string const & filename) const;
 
   [[nodiscard]] int width() const { return width_; }
 
@@ -2,23 +2,14 @@
 #define SOA_RAY_HPP
 
 // #include "soa_color.hpp"
+#include "../../common/include/ray.hpp"
 #include "../../common/include/vector.hpp"
 #include <optional>
 
 namespace ray {
 
-  // Estructura para representar un rayo
-  struct Ray {
-    render::vector origin;
-    render::vector direction;
-
-    Ray() = default;
-
-    Ray(render::vector const & o, render::vector const & d) : origin(o), direction(d) { }
-
-    // Calculamos un punto a lo largo del rayo: P(t) = origin + t * direction
-    [[nodiscard]] render::vector at(double t) const { return origin + direction * t; }
-  };
+  // Rayo de common (render::ray, con orig y dir): el mismo tipo en common, AOS y SOA
+  using Ray = render::ray;
 
   // Intersección RAYO-OBJETO
   struct HitRecord {
@@ -29,7 +20,7 @@ namespace ray {
 
     // Normal según la dirección del rayo
     void set_face_normal(Ray const & r, render::vector const & outward_normal) {
-      front_face = render::dot(r.direction, outward_normal) < 0;
+      front_face = render::dot(r.dir, outward_normal) < 0;
       normal     = front_face ? outward_normal : -outward_normal;
     }
   };
@@ -48,6 +39,9 @@ namespace ray {
 
   // Constante mínima para evitar auto-intersecciones
   constexpr double MIN_DISTANCE = 1e-3;
+  // la misma en el escalar de las columnas de la cola de caminos, para que los bucles en float
+  // no conviertan cada carril a double
+  constexpr render::real MIN_DISTANCE_REAL = static_cast<render::real>(MIN_DISTANCE);
 
   // Intersección RAYO-ESFERA
   [[nodiscard]] std::optional<HitRecord> hit_sphere(Ray const & r, render::vector const & center,
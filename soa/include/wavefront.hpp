@@ -0,0 +1,102 @@
+#ifndef SOA_WAVEFRONT_HPP
+#define SOA_WAVEFRONT_HPP
+
+#include "../../common/include/config.hpp"
+#include "../../common/include/math_utilities.hpp"
+#include "../../common/include/running_stats.hpp"
+#include "../../common/include/sampler.hpp"
+#include "../../common/include/scatter_batch.hpp"
+#include "../../common/include/scene_parser.hpp"
+#include "path_queue.hpp"
+#include "ray_sort.hpp"
+#include "soa_camera.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace soa {
+
+  // RESULTADO DE UNA FILA: suma del color de las muestras terminadas de cada píxel, su
+  // luminancia (para el muestreo adaptativo) y los rayos trazados (para --heatmap)
+  struct RowAccumulator {
+    explicit RowAccumulator(std::size_t width);
+
+    void reset();
+
+    std::vector<double> r, g, b;
+    std::vector<render::RunningStats> stats;
+    std::vector<std::uint32_t> taken;
+    std::vector<std::uint64_t> segments;
+    // el píxel recibe muestras en la siguiente ola
+    std::vector<std::uint8_t> active;
+  };
+
+  // Datos de solo lectura del trazador
+  struct WavefrontScene {
+    ConfigParams const & cfg;
+    SceneOutput const & scene;
+    Viewport view;
+    render::Sampler const & sampler;
+  };
+
+  // TRAZADOR DE CAMINOS POR OLAS (wavefront)
+  // Cada ola lleva todas las muestras pendientes de una fila a la vez por las etapas
+  //   generate:  rayos de cámara con offset dentro del píxel
+  //   intersect: bucle por objeto sobre todos los rayos; se queda con el impacto más cercano.
+  //              En la primera vuelta (rayos de cámara) va por paquetes (ray_packet.hpp).
+  //              En modo RENDER_FLOAT se busca en float y el impacto elegido se recalcula en
+  //              double (refine_hits)
+  //   shade:     fondo si no hay impacto; si lo hay, los impactos se agrupan por material y
+  //              cada grupo se dispersa con un kernel por lotes (scatter_batch.hpp)
+  //   compact:   mueve al principio de la cola los caminos que siguen
+  //   extend:    cuenta el rebote de los que siguen; su rayo dispersado (escrito por shade en
+  //              la posición del camino) es el de la siguiente vuelta
+  // hasta que no queda ningún camino. Con SOA_SORT_RAYS la cola se reordena además antes de
+  // intersect (salvo en la primera vuelta, ray_sort.hpp).
+  // Los números aleatorios salen de los RNG sembrados con rayrngseed y materialrngseed o, con
+  // otra secuencia en 'sampler', del punto de cada muestra
+  class WavefrontTracer {
+  public:
+    // 'capacity': caminos de la ola más grande (ancho de la imagen por muestras por ola)
+    WavefrontTracer(WavefrontScene const & scene, std::size_t capacity);
+
+    // encola 'samples' muestras de cada píxel activo de la fila 'row'
+    void generate(int row, std::uint32_t samples, RowAccumulator const & acc);
+
+    // traza los caminos encolados hasta que terminan y suma su color en 'acc'
+    void trace(RowAccumulator & acc);
+
+    // etapa intersect sola sobre los caminos encolados ('primary': rayos de cámara, por
+    // paquetes); trace la encadena con las demás. Con queue() se leen sus impactos
+    void intersect(bool primary);
+
+    [[nodiscard]] PathQueue const & queue() const { return queue_; }
+
+  private:
+    void intersect_packets();
+    void intersect_spheres(std::size_t begin, std::size_t end);
+    void intersect_cylinders(std::size_t begin, std::size_t end);
+    void refine_hits();
+    void shade(RowAccumulator & acc);
+    void shade_misses(RowAccumulator & acc);
+    void load_batch(std::span<std::uint32_t const> run);
+    void apply_batch(RowAccumulator & acc, std::span<std::uint32_t const> run,
+                     render::color_vector const & attenuation);
+    void extend();
+
+    WavefrontScene scene_;
+    PathQueue queue_;
+    RaySorter sorter_;
+    render::ScatterBatch batch_;
+    // 0, 1, 2... para recorrer la cola cuando no hace falta agruparla
+    std::vector<std::uint32_t> identity_;
+    render::RNG ray_rng_;
+    render::RNG material_rng_;
+    int row_ = 0;
+  };
+
+}  // namespace soa
+
+#endif  // SOA_WAVEFRONT_HPP
@@ -1,9 +1,12 @@
-#include <print>
+#include <string>
+#include <vector>
 
-#include "vector.hpp"
+#include "renderer.hpp"
 
-int main() {
-  std::println("Starting SOA rendering");
-  render::vector vec{1.0, 2.0, 3.0};
-  std::println("Vector magnitude: {}", vec.magnitude());
+// --- Función Principal ---
+
+// render-soa traza con el backend SOA salvo que --backend pida el otro
+int main(int argc, char * argv[]) {
+  std::vector<std::string> const args(argv, argv + argc);
+  return render::run_renderer(args, Backend::SOA);
 }
@@ -0,0 +1,73 @@
+#include "../include/path_queue.hpp"
+
+namespace soa {
+
+  namespace {
+
+    template <typename T>
+    void gather_column(std::vector<T> & dst, std::vector<T> const & src,
+                       std::span<std::uint32_t const> order) {
+      for (std::size_t k = 0; k < order.size(); ++k) {
+        dst[k] = src[order[k]];
+      }
+    }
+
+  }  // namespace
+
+  PathQueue::PathQueue(std::size_t capacity)
+      : origin_x(capacity), origin_y(capacity), origin_z(capacity), dir_x(capacity),
+        dir_y(capacity), dir_z(capacity), weight_r(capacity), weight_g(capacity),
+        weight_b(capacity), pixel(capacity), sample(capacity), dimension(capacity),
+        depth(capacity), hit_t(capacity), normal_x(capacity), normal_y(capacity),
+        normal_z(capacity), hit_object(capacity), hit_material(capacity),
+        uniforms{std::vector<double>(capacity), std::vector<double>(capacity),
+                 std::vector<double>(capacity)},
+        alive(capacity) { }
+
+  void PathQueue::move(std::size_t from, std::size_t to) {
+    origin_x[to]  = origin_x[from];
+    origin_y[to]  = origin_y[from];
+    origin_z[to]  = origin_z[from];
+    dir_x[to]     = dir_x[from];
+    dir_y[to]     = dir_y[from];
+    dir_z[to]     = dir_z[from];
+    weight_r[to]  = weight_r[from];
+    weight_g[to]  = weight_g[from];
+    weight_b[to]  = weight_b[from];
+    pixel[to]     = pixel[from];
+    sample[to]    = sample[from];
+    dimension[to] = dimension[from];
+    depth[to]     = depth[from];
+  }
+
+  void PathQueue::compact() {
+    std::size_t out = 0;
+    for (std::size_t k = 0; k < size; ++k) {
+      if (alive[k] != 0) {
+        if (k != out) {
+          move(k, out);
+        }
+        ++out;
+      }
+    }
+    size = out;
+  }
+
+  void PathQueue::gather(PathQueue const & src, std::span<std::uint32_t const> order) {
+    gather_column(origin_x, src.origin_x, order);
+    gather_column(origin_y, src.origin_y, order);
+    gather_column(origin_z, src.origin_z, order);
+    gather_column(dir_x, src.dir_x, order);
+    gather_column(dir_y, src.dir_y, order);
+    gather_column(dir_z, src.dir_z, order);
+    gather_column(weight_r, src.weight_r, order);
+    gather_column(weight_g, src.weight_g, order);
+    gather_column(weight_b, src.weight_b, order);
+    gather_column(pixel, src.pixel, order);
+    gather_column(sample, src.sample, order);
+    gather_column(dimension, src.dimension, order);
+    gather_column(depth, src.depth, order);
+    size = order.size();
+  }
+
+}  // namespace soa
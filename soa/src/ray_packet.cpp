@@ -0,0 +1,82 @@
+#include "../include/ray_packet.hpp"
+
+#include <cmath>
+
+namespace soa {
+
+  namespace {
+
+    // holgura relativa de las esferas envolventes y de los ángulos del cono para que el redondeo
+    // nunca descarte un objeto que algún rayo sí toca
+    constexpr double BOUND_MARGIN = 1e-9;
+
+  }  // namespace
+
+  BoundingSphere bounding_sphere(Sphere const & sph) {
+    return {
+      .center = render::vector{sph.center_x, sph.center_y, sph.center_z},
+      .radius = sph.radius,
+    };
+  }
+
+  // la superficie y las bases quedan dentro de la esfera que pasa por el borde de las bases
+  BoundingSphere bounding_sphere(Cylinder const & cyl) {
+    double const half_height = cyl.height / 2.0;
+    return {
+      .center = render::vector{cyl.center_x, cyl.center_y, cyl.center_z},
+      .radius = std::sqrt(cyl.radius * cyl.radius + half_height * half_height),
+    };
+  }
+
+  ray::CylinderParams cylinder_params(Cylinder const & cyl) {
+    return {
+      .center = render::vector{cyl.center_x, cyl.center_y, cyl.center_z},
+      .radius = cyl.radius,
+      .axis   = render::vector{cyl.axis_x, cyl.axis_y, cyl.axis_z},
+      .height = cyl.height,
+    };
+  }
+
+  // Los rayos primarios tienen dirección unitaria, así que t es la distancia al vértice. El cono
+  // no toca la esfera si el ángulo entre su eje y el centro supera su semiángulo más el radio
+  // angular de la esfera (ambos menores de 90°, la suma no da la vuelta)
+  bool cone_misses(PacketCone const & cone, BoundingSphere const & bound, double max_t) {
+    render::vector const to_center = bound.center - cone.apex;
+    double const dist              = to_center.magnitude();
+    double const radius            = bound.radius * (1.0 + BOUND_MARGIN);
+    if (dist <= radius) {
+      return false;
+    }
+    if (dist - radius > max_t) {
+      return true;
+    }
+    double const sin_radius = radius / dist;
+    double const cos_radius = std::sqrt(1.0 - sin_radius * sin_radius);
+    double const cos_center = render::dot(cone.axis, to_center) / dist;
+    double const cos_limit  = cos_radius * cone.cos_half - sin_radius * cone.sin_half;
+    return cos_center < cos_limit - BOUND_MARGIN;
+  }
+
+  void intersect_cylinder_lane(PathQueue & q, std::size_t k, Cylinder const & cyl,
+                               ray::CylinderParams const & params) {
+    ray::Ray const r{
+      render::vector{q.origin_x[k], q.origin_y[k], q.origin_z[k]},
+      render::vector{   q.dir_x[k],    q.dir_y[k],    q.dir_z[k]}
+    };
+    auto const rec = ray::hit_cylinder(r, params, {ray::MIN_DISTANCE, q.hit_t[k]});
+    RENDER_STAT(
+        render::thread_stats().count_intersection(render::CYLINDER_TYPE, rec.has_value()));
+    RENDER_STAT(render::thread_stats().count_object(cyl.source_line, rec.has_value()));
+    if (rec and rec->t < q.hit_t[k]) {
+      // hit_cylinder devuelve la normal orientada contra el rayo; se guarda la exterior
+      render::vector const outward = rec->front_face ? rec->normal : -rec->normal;
+      q.hit_t[k]                   = static_cast<render::real>(rec->t);
+      q.hit_object[k]              = &cyl;
+      q.hit_material[k]            = cyl.material_ptr;
+      q.normal_x[k]                = static_cast<render::real>(outward.get_x());
+      q.normal_y[k]                = static_cast<render::real>(outward.get_y());
+      q.normal_z[k]                = static_cast<render::real>(outward.get_z());
+    }
+  }
+
+}  // namespace soa
@@ -0,0 +1,157 @@
+#include "../include/ray_sort.hpp"
+
+#include "../../common/include/trace.hpp"
+#include "../include/ray_packet.hpp"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <span>
+#include <utility>
+
+namespace soa {
+
+  namespace {
+
+    // dígitos de 9 bits: las claves caben en 3 y las habituales se ordenan en 2 pasadas
+    constexpr unsigned RADIX_BITS      = 9;
+    constexpr std::size_t RADIX_SIZE   = std::size_t{1} << RADIX_BITS;
+    constexpr std::uint32_t RADIX_MASK = RADIX_SIZE - 1;
+    constexpr unsigned KEY_BITS        = 27;
+
+    constexpr unsigned MORTON_BITS    = 5;
+    constexpr double MORTON_CELLS     = 1U << MORTON_BITS;
+    constexpr unsigned OCTANT_SHIFT   = 3 * MORTON_BITS;
+    constexpr unsigned MATERIAL_SHIFT = 16;
+
+    // intercala dos ceros entre los bits de v (hasta 10 bits)
+    std::uint32_t spread_bits(std::uint32_t v) {
+      v = (v | (v << 16U)) & 0x0300'00FFU;
+      v = (v | (v << 8U)) & 0x0300'F00FU;
+      v = (v | (v << 4U)) & 0x030C'30C3U;
+      v = (v | (v << 2U)) & 0x0924'9249U;
+      return v;
+    }
+
+    // celda de 'value' al dividir [min, max] en MORTON_CELLS partes
+    std::uint32_t quantize(double value, double min, double max) {
+      double const extent = max - min;
+      double const cell   = extent > 0.0 ? (value - min) / extent * MORTON_CELLS : 0.0;
+      return static_cast<std::uint32_t>(std::clamp(cell, 0.0, MORTON_CELLS - 1.0));
+    }
+
+    render::vector component_min(render::vector const & a, render::vector const & b) {
+      return {std::min(a.get_x(), b.get_x()), std::min(a.get_y(), b.get_y()),
+              std::min(a.get_z(), b.get_z())};
+    }
+
+    render::vector component_max(render::vector const & a, render::vector const & b) {
+      return {std::max(a.get_x(), b.get_x()), std::max(a.get_y(), b.get_y()),
+              std::max(a.get_z(), b.get_z())};
+    }
+
+    void add_bound(SceneBox & box, BoundingSphere const & bound) {
+      render::vector const r{bound.radius, bound.radius, bound.radius};
+      box.min = component_min(box.min, bound.center - r);
+      box.max = component_max(box.max, bound.center + r);
+    }
+
+    template <typename Derived>
+    std::uint32_t material_index(render::MaterialBase const * mat,
+                                 std::vector<Derived> const & materials) {
+      return static_cast<std::uint32_t>(static_cast<Derived const *>(mat) - materials.data());
+    }
+
+  }  // namespace
+
+  SceneBox scene_box(SceneOutput const & scene, render::vector const & camera) {
+    SceneBox box{.min = camera, .max = camera};
+    for (Sphere const & sph : scene.spheres.get()) {
+      add_bound(box, bounding_sphere(sph));
+    }
+    for (Cylinder const & cyl : scene.cylinders.get()) {
+      add_bound(box, bounding_sphere(cyl));
+    }
+    return box;
+  }
+
+  std::uint32_t direction_origin_key(render::vector const & origin, render::vector const & dir,
+                                     SceneBox const & box) {
+    std::uint32_t const octant = (dir.get_x() < 0.0 ? 1U : 0U) | (dir.get_y() < 0.0 ? 2U : 0U) |
+                                 (dir.get_z() < 0.0 ? 4U : 0U);
+    std::uint32_t const x = quantize(origin.get_x(), box.min.get_x(), box.max.get_x());
+    std::uint32_t const y = quantize(origin.get_y(), box.min.get_y(), box.max.get_y());
+    std::uint32_t const z = quantize(origin.get_z(), box.min.get_z(), box.max.get_z());
+    return (octant << OCTANT_SHIFT) | (spread_bits(x) << 2U) | (spread_bits(y) << 1U) |
+           spread_bits(z);
+  }
+
+  std::uint32_t material_key(render::MaterialBase const * mat, SceneOutput const & scene) {
+    if (mat == nullptr) {
+      return 0;
+    }
+    std::uint32_t index = 0;
+    switch (mat->type) {
+      case render::MATTE_TYPE: index = material_index(mat, scene.matte_materials.get()); break;
+      case render::METAL_TYPE: index = material_index(mat, scene.metal_materials.get()); break;
+      case render::REFRACTIVE_TYPE:
+        index = material_index(mat, scene.refractive_materials.get());
+        break;
+    }
+    return ((static_cast<std::uint32_t>(mat->type) + 1U) << MATERIAL_SHIFT) | index;
+  }
+
+  RaySorter::RaySorter(SceneOutput const & scene, render::vector const & camera,
+                       std::size_t capacity)
+      : scene_(scene), box_(scene_box(scene, camera)), keys_(capacity), keys_tmp_(capacity),
+        order_(capacity), order_tmp_(capacity), scratch_(capacity) { }
+
+  void RaySorter::sort_for_intersect(PathQueue & q) {
+    render::ScopedTimer const timer("ray_sort", "render");
+    for (std::size_t k = 0; k < q.size; ++k) {
+      keys_[k] = direction_origin_key(render::vector{q.origin_x[k], q.origin_y[k], q.origin_z[k]},
+                                      render::vector{q.dir_x[k], q.dir_y[k], q.dir_z[k]}, box_);
+    }
+    if (sort_keys(q.size)) {
+      scratch_.gather(q, std::span<std::uint32_t const>(order_.data(), q.size));
+      std::swap(q, scratch_);
+    }
+  }
+
+  std::span<std::uint32_t const> RaySorter::bin_by_material(PathQueue const & q) {
+    render::ScopedTimer const timer("ray_sort", "render");
+    for (std::size_t k = 0; k < q.size; ++k) {
+      keys_[k] = material_key(q.hit_material[k], scene_);
+    }
+    if (!sort_keys(q.size)) {
+      return {};
+    }
+    return {order_.data(), q.size};
+  }
+
+  // radix LSD estable; los dígitos iguales en todas las claves no necesitan pasada
+  bool RaySorter::sort_keys(std::size_t n) {
+    std::iota(order_.begin(), order_.begin() + static_cast<std::ptrdiff_t>(n), 0U);
+    bool reordered = false;
+    for (unsigned shift = 0; shift < KEY_BITS; shift += RADIX_BITS) {
+      std::array<std::size_t, RADIX_SIZE + 1> offsets{};
+      for (std::size_t k = 0; k < n; ++k) {
+        ++offsets[((keys_[k] >> shift) & RADIX_MASK) + 1];
+      }
+      if (std::ranges::find(offsets, n) != offsets.end()) {
+        continue;
+      }
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      for (std::size_t k = 0; k < n; ++k) {
+        std::size_t const pos = offsets[(keys_[k] >> shift) & RADIX_MASK]++;
+        keys_tmp_[pos]        = keys_[k];
+        order_tmp_[pos]       = order_[k];
+      }
+      std::swap(keys_, keys_tmp_);
+      std::swap(order_, order_tmp_);
+      reordered = true;
+    }
+    return reordered;
+  }
+
+}  // namespace soa
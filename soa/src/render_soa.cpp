@@ -1,112 +1,172 @@
 #include "../include/render_soa.hpp"
 
-#include "../../common/include/vector.hpp"
-#include "../include/soa_color.hpp"
-#include "../include/soa_ray.hpp"
+#include "../../common/include/sampler.hpp"
+#include "../../common/include/trace.hpp"
+#include "../include/wavefront.hpp"
 
 #include <algorithm>
-#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <numeric>
 
 namespace soa {
 
   namespace {
 
-    // Colorea por normal en [0,1]
-    inline color::Color normal_to_color(render::vector const & n) {
-      return color::Color{0.5 * (n.get_x() + 1.0), 0.5 * (n.get_y() + 1.0),
-                          0.5 * (n.get_z() + 1.0)};
+    // Datos compartidos por todas las filas
+    struct RowContext {
+      ConfigParams const & cfg;
+      render::GammaLUT const & lut;
+      WavefrontTracer & tracer;
+      RowAccumulator & acc;
+    };
+
+    // muestras por píxel de la primera ola de cada fila: todas, o el mínimo en modo adaptativo
+    std::uint32_t first_wave_samples(ConfigParams const & cfg) {
+      int const samples = cfg.adaptive_sampling() ? cfg.adaptive_min_samples
+                                                  : std::max(1, cfg.samples_per_pixel);
+      return static_cast<std::uint32_t>(samples);
     }
 
-    inline color::Color background_for_dir(double dy, ConfigParams const & cfg) {
-      color::Color light{cfg.background_light_color_r, cfg.background_light_color_g,
-                         cfg.background_light_color_b};
-      color::Color dark{cfg.background_dark_color_r, cfg.background_dark_color_g,
-                        cfg.background_dark_color_b};
-      return color::background_color(dy, light, dark);
+    // modo adaptativo: tras cada ola solo siguen (con una muestra más) los píxeles que no han
+    // llegado al máximo ni convergido; devuelve si queda alguno
+    bool update_active(ConfigParams const & cfg, RowAccumulator & acc) {
+      auto const max_samples = static_cast<std::uint32_t>(cfg.adaptive_max_samples);
+      bool any               = false;
+      for (std::size_t i = 0; i < acc.active.size(); ++i) {
+        bool const more = acc.taken[i] < max_samples and
+                          !acc.stats[i].converged(cfg.adaptive_threshold);
+        acc.active[i]   = more ? 1 : 0;
+        any             = any or more;
+      }
+      return any;
     }
 
-    struct HitResult {
-      bool hit{false};
-      double t{0};
-      render::vector normal;
-    };
+    // reparte el coste medido para toda la fila entre sus píxeles según los rayos de cada uno:
+    // con --heatmap-metric tests es exacto (cada rayo prueba todos los objetos)
+    void add_row_cost(RowAccumulator const & acc, int j, std::uint64_t cost,
+                      render::CostMap & cost_map) {
+      std::uint64_t const total = std::accumulate(acc.segments.begin(), acc.segments.end(),
+                                                  std::uint64_t{0});
+      for (std::size_t i = 0; total > 0 and i < acc.segments.size(); ++i) {
+        double const share = static_cast<double>(acc.segments[i]) / static_cast<double>(total);
+        cost_map.add_cost(static_cast<int>(i), j,
+                          static_cast<std::uint64_t>(share * static_cast<double>(cost)));
+      }
+    }
 
-    // Intersecta con todas las esferas y cilindros y devuelve el más cercano
-    HitResult closest_hit(ray::Ray const & r, SceneOutput const & scene) {
-      HitResult result{};
-      ray::IntersectionParams params{ray::MIN_DISTANCE, 1e18};
-
-      // Esferas
-      for (auto const & sph : scene.spheres.get()) {
-        auto center = render::vector{sph.center_x, sph.center_y, sph.center_z};
-        auto rec    = ray::hit_sphere(r, center, sph.radius, params);
-        if (rec and (!result.hit or rec->t < result.t)) {
-          result.hit    = true;
-          result.t      = rec->t;
-          result.normal = rec->normal;
-          params.t_max  = rec->t;  // acotamos para siguientes
-        }
+    // escribe en std::cerr el tamaño de la imagen y las muestras (fijas o el rango adaptativo)
+    void print_header(ConfigParams const & cfg) {
+      std::cerr << "Renderizando SOA... (Ancho=" << cfg.image_width
+                << ", Alto=" << cfg.get_image_height();
+      if (cfg.adaptive_sampling()) {
+        std::cerr << ", Muestras adaptativas=" << cfg.adaptive_min_samples << "-"
+                  << cfg.adaptive_max_samples << ", Umbral=" << cfg.adaptive_threshold << ")\n";
+      } else {
+        std::cerr << ", Muestras=" << cfg.samples_per_pixel << ")\n";
       }
+    }
 
-      // Cilindros
-      for (auto const & cyl : scene.cylinders.get()) {
-        ray::CylinderParams cp{};
-        cp.center = render::vector{cyl.center_x, cyl.center_y, cyl.center_z};
-        cp.radius = cyl.radius;
-        cp.axis   = render::vector{cyl.axis_x, cyl.axis_y, cyl.axis_z};
-        cp.height = cyl.height;
-        auto rec  = ray::hit_cylinder(r, cp, params);
-        if (rec and (!result.hit or rec->t < result.t)) {
-          result.hit    = true;
-          result.t      = rec->t;
-          result.normal = rec->normal;
-          params.t_max  = rec->t;
-        }
+    // Renderiza la fila j en la imagen por olas; devuelve los rayos primarios trazados
+    std::uint64_t render_row(RowContext const & ctx, int j, RenderTarget const & target) {
+      render::ScopedTimer const row_timer("row", "render", j);
+      std::uint64_t const cost_start = target.cost_map ? target.cost_map->probe() : 0;
+      RowAccumulator & acc           = ctx.acc;
+      acc.reset();
+      ctx.tracer.generate(j, first_wave_samples(ctx.cfg), acc);
+      ctx.tracer.trace(acc);
+      while (ctx.cfg.adaptive_sampling() and update_active(ctx.cfg, acc)) {
+        ctx.tracer.generate(j, 1, acc);
+        ctx.tracer.trace(acc);
       }
 
-      return result;
+      // Promedio por muestras
+      std::uint64_t traced = 0;
+      for (std::size_t i = 0; i < acc.taken.size(); ++i) {
+        double const inv_spp  = 1.0 / static_cast<double>(acc.taken[i]);
+        acc.r[i]             *= inv_spp;
+        acc.g[i]             *= inv_spp;
+        acc.b[i]             *= inv_spp;
+        traced               += acc.taken[i];
+      }
+      target.image.set_row(j, render::LinearRow{acc.r, acc.g, acc.b}, ctx.lut);
+      if (target.cost_map) {
+        add_row_cost(acc, j, target.cost_map->probe() - cost_start, *target.cost_map);
+      }
+      if (target.progress != nullptr) {
+        target.progress->advance(1, traced);
+      }
+      return traced;
     }
 
   }  // namespace
 
-  void render_scene(ConfigParams const & cfg, SceneOutput const & scene, CameraSOA & camera,
-                    SOAImage & image) {
-    int w   = image.width();
-    int h   = image.height();
-    int spp = std::max(1, cfg.samples_per_pixel);
-    camera.generate_primary_rays(static_cast<std::size_t>(w), static_cast<std::size_t>(h),
-                                 static_cast<std::size_t>(spp));
+  std::uint64_t render_scene(ConfigParams const & cfg, SceneOutput const & scene,
+                             CameraSOA const & camera, RenderTarget const & target) {
+    int const w      = target.image.width();
+    int const h      = target.image.height();
+    auto const width = static_cast<std::size_t>(w);
+    render::Sampler const sampler(cfg.sampler, static_cast<std::uint64_t>(cfg.ray_rng_seed));
+    WavefrontScene const wave_scene{
+      .cfg     = cfg,
+      .scene   = scene,
+      .view    = camera.viewport(width, static_cast<std::size_t>(h)),
+      .sampler = sampler,
+    };
+    // La ola más grande es la primera de cada fila
+    WavefrontTracer tracer(wave_scene, width * first_wave_samples(cfg));
+    RowAccumulator acc(width);
+    render::GammaLUT const lut(cfg.gamma);
+    RowContext const ctx{.cfg = cfg, .lut = lut, .tracer = tracer, .acc = acc};
+    std::uint64_t traced = 0;
     for (int j = 0; j < h; ++j) {
-      for (int i = 0; i < w; ++i) {
-        color::Color accum{0.0, 0.0, 0.0};
-        std::size_t base = (static_cast<std::size_t>(j) * static_cast<std::size_t>(w) +
-                            static_cast<std::size_t>(i)) *
-                           static_cast<std::size_t>(spp);
-        for (int s = 0; s < spp; ++s) {
-          std::size_t si  = static_cast<std::size_t>(s);
-          std::size_t idx = base + si;
-          auto ox = camera.origins_x[idx], oy = camera.origins_y[idx], oz = camera.origins_z[idx];
-          auto dx = camera.dirs_x[idx], dy = camera.dirs_y[idx], dz = camera.dirs_z[idx];
-          ray::Ray r{
-            render::vector{ox, oy, oz},
-            render::vector{dx, dy, dz}
-          };
-          auto hit = closest_hit(r, scene);
-          color::Color c{};
-          if (hit.hit) {
-            c = normal_to_color(hit.normal);
-          } else {
-            c = background_for_dir(dy, cfg);
-          }
-          accum = accum + c;
-        }
-
-        // Promedio por muestras
-        double inv_spp = 1.0 / static_cast<double>(spp);
-        RGBColor out_color{accum.r * inv_spp, accum.g * inv_spp, accum.b * inv_spp};
-        image.setPixel(j, i, out_color, cfg.gamma);
+      traced += render_row(ctx, j, target);
+    }
+    return traced;
+  }
+
+  bool SOARenderer::render(render::RenderJob const & job, std::uint64_t & primary_rays) {
+    RenderOptions const & options = job.options;
+    ConfigParams const & config   = job.config;
+    if (options.resume or options.progressive or options.time_budget > 0) {
+      std::cerr << "Aviso: el backend SOA solo admite el render completo; se ignoran --resume, "
+                   "--progressive y --time-budget\n";
+    }
+    int const image_width  = config.image_width;
+    int const image_height = config.get_image_height();
+    print_header(config);
+
+    CameraSOA const camera(config);
+    SOAImage image(image_width, image_height);
+    std::optional<render::CostMap> cost_map;
+    if (!options.heatmap_file.empty()) {
+      cost_map.emplace(image_width, image_height,
+                       options.heatmap_time ? render::CostMap::Metric::TIME
+                                            : render::CostMap::Metric::TESTS);
+    }
+    render::ProgressReporter progress(static_cast<std::uint64_t>(image_height), "filas",
+                                      options.quiet);
+    RenderTarget const target{
+      .image = image, .cost_map = cost_map ? &*cost_map : nullptr, .progress = &progress};
+    primary_rays = render_scene(config, job.scene, camera, target);
+    progress.finish();
+    if (!image.write_ppm(options.output_file)) {
+      return false;
+    }
+    std::cerr << "¡Renderizado SOA completado!\nImagen guardada en: " << options.output_file
+              << '\n';
+
+    // --- Mapa de coste por píxel (--heatmap) ---
+    if (cost_map) {
+      if (!cost_map->write_ppm(options.heatmap_file, false)) {
+        return false;
       }
+      std::cerr << "Mapa de coste guardado en: " << options.heatmap_file << " (máximo "
+                << cost_map->max_cost() << (options.heatmap_time ? " ns" : " pruebas")
+                << " por píxel)\n";
     }
+    return true;
   }
 
 }  // namespace soa
@@ -1,4 +1,5 @@
 #include "../include/soa_camera.hpp"
+#include "../../common/include/trace.hpp"
 #include <cmath>
 
 namespace {
@@ -17,7 +18,8 @@ namespace {
 
 namespace soa {
 
-  CameraSOA::CameraSOA(ConfigParams const & c)
+  template <typename T>
+  BasicCameraSOA<T>::BasicCameraSOA(ConfigParams const & c)
       : OX(c.camera_x), OY(c.camera_y), OZ(c.camera_z), FOV(c.field_of_view * M_PI / 180.0) {
     // Origen y vectores base
 
@@ -45,26 +47,34 @@ namespace soa {
     VZ = WX * UY - WY * UX;
   }
 
-  void CameraSOA::generate_primary_rays(std::size_t w, std::size_t h, std::size_t spp) {
+  template <typename T>
+  Viewport BasicCameraSOA<T>::viewport(std::size_t w, std::size_t h) const {
+    double hp     = 2.0 * std::tan(FOV * 0.5) * DF;
+    double aspect = static_cast<double>(w) / static_cast<double>(h);
+    double wp     = hp * aspect;
+    render::vector const horizontal{wp * UX, wp * UY, wp * UZ};
+    render::vector const vertical{hp * VX, hp * VY, hp * VZ};
+    render::vector const origin{OX, OY, OZ};
+    render::vector const forward{WX, WY, WZ};
+    return {.origin = origin,
+            .corner = origin - 0.5 * horizontal - 0.5 * vertical - DF * forward,
+            .step_x = horizontal / static_cast<double>(w),
+            .step_y = vertical / static_cast<double>(h)};
+  }
+
+  template <typename T>
+  void BasicCameraSOA<T>::generate_primary_rays(std::size_t w, std::size_t h, std::size_t spp) {
+    render::ScopedTimer const timer("generate_primary_rays", "camera");
     if (w == 0 or h == 0 or spp == 0) {
       origins_x.clear(), origins_y.clear(), origins_z.clear(), dirs_x.clear(), dirs_y.clear(),
           dirs_z.clear();
       return;
     }
-    double hp     = 2.0 * std::tan(FOV * 0.5) * DF;
-    double aspect = static_cast<double>(w) / static_cast<double>(h);
-    double wp     = hp * aspect;
-    double phx = wp * UX, phy = wp * UY, phz = wp * UZ;
-    double pvx = hp * VX, pvy = hp * VY, pvz = hp * VZ;
-    double p0x  = OX - 0.5 * phx - 0.5 * pvx - DF * WX;
-    double p0y  = OY - 0.5 * phy - 0.5 * pvy - DF * WY;
-    double p0z  = OZ - 0.5 * phz - 0.5 * pvz - DF * WZ;
-    double dx_x = phx / double(w), dx_y = phy / double(w), dx_z = phz / double(w);
-    double dy_x = pvx / double(h), dy_y = pvy / double(h), dy_z = pvz / double(h);
-    std::size_t total = w * h * spp;
-    origins_x.assign(total, OX);
-    origins_y.assign(total, OY);
-    origins_z.assign(total, OZ);
+    Viewport const view = viewport(w, h);
+    std::size_t total   = w * h * spp;
+    origins_x.assign(total, static_cast<T>(OX));
+    origins_y.assign(total, static_cast<T>(OY));
+    origins_z.assign(total, static_cast<T>(OZ));
     dirs_x.resize(total);
     dirs_y.resize(total);
     dirs_z.resize(total);
@@ -72,19 +82,19 @@ namespace soa {
       double ry = double(j) + 0.5;
       for (std::size_t i = 0; i < w; ++i) {
         double rx = double(i) + 0.5;
-        double px = p0x + rx * dx_x + ry * dy_x;
-        double py = p0y + rx * dx_y + ry * dy_y;
-        double pz = p0z + rx * dx_z + ry * dy_z;
-        double dx = px - OX, dy = py - OY, dz = pz - OZ;
-        norm(dx, dy, dz);
+        render::vector const dir =
+            render::unit_vector(view.corner + rx * view.step_x + ry * view.step_y - view.origin);
         std::size_t base = ((j * w) + i) * spp;
         for (std::size_t s = 0; s < spp; ++s) {
-          dirs_x[base + s] = dx;
-          dirs_y[base + s] = dy;
-          dirs_z[base + s] = dz;
+          dirs_x[base + s] = static_cast<T>(dir.get_x());
+          dirs_y[base + s] = static_cast<T>(dir.get_y());
+          dirs_z[base + s] = static_cast<T>(dir.get_z());
         }
       }
     }
   }
 
+  template class BasicCameraSOA<double>;
+  template class BasicCameraSOA<float>;
+
 }  // namespace soa
@@ -1,8 +1,10 @@
 #include "../include/soa_image.hpp"
+#include "../../common/include/trace.hpp"
 #include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iostream>
+#include <span>
 #include <sys/stat.h>
 
 // Inicializamos los tres canales a 0
@@ -21,6 +23,15 @@ void SOAImage::setPixel(int row, int col, RGBColor const & color, double gamma)
   blue_channel_[idx]  = to_byte(color.b, gamma);
 }
 
+// Cuantizamos cada canal de la fila directamente sobre su plano de la imagen
+void SOAImage::set_row(int row, render::LinearRow const & linear, render::GammaLUT const & lut) {
+  size_t const start = index(row, 0);
+  size_t const width = static_cast<size_t>(width_);
+  lut.quantize(linear.r.first(width), std::span(red_channel_).subspan(start, width));
+  lut.quantize(linear.g.first(width), std::span(green_channel_).subspan(start, width));
+  lut.quantize(linear.b.first(width), std::span(blue_channel_).subspan(start, width));
+}
+
 // Convertimos el valor [0, 1] a [0, 255] con corrección gamma
 uint8_t SOAImage::to_byte(double value, double gamma) {
   // Primero cambiamos al rango
@@ -34,11 +45,12 @@ uint8_t SOAImage::to_byte(double value, double gamma) {
 }
 
 // Escribimos la imagen en un archivo PPM
-void SOAImage::write_ppm(std::string const & filename) const {
+bool SOAImage::write_ppm(std::string const & filename) const {
+  render::ScopedTimer const timer("write_ppm", "io");
   std::ofstream file(filename, std::ios::binary);
   if (!file.is_open()) {
     std::cerr << "Error: Cannot create output file " << filename << '\n';
-    return;
+    return false;
   }
 
   file << "P6\n" << width_ << " " << height_ << "\n255\n";
@@ -50,4 +62,9 @@ void SOAImage::write_ppm(std::string const & filename) const {
   }
 
   file.close();
+  if (!file) {
+    std::cerr << "Error: Cannot write output file " << filename << '\n';
+    return false;
+  }
+  return true;
 }
@@ -11,11 +11,11 @@ namespace ray {
   std::optional<HitRecord> hit_sphere(Ray const & r, render::vector const & center, double radius,
                                       IntersectionParams const & params) {
     // Vector del origen del rayo al centro de la esfera
-    render::vector rc = center - r.origin;
+    render::vector rc = center - r.orig;
 
-    // Coeficientes de la ecuación de segundo grado
-    double a = render::dot(r.direction, r.direction);
-    double b = 2.0 * render::dot(r.direction, rc);
+    // Coeficientes de la ecuación de segundo grado: |t*d - rc|^2 = radio^2
+    double a = render::dot(r.dir, r.dir);
+    double b = -2.0 * render::dot(r.dir, rc);
     double c = render::dot(rc, rc) - radius * radius;
 
     // Discriminante
@@ -72,9 +72,9 @@ namespace ray {
     std::optional<HitRecord> hit_cylinder_surface(Ray const & r, CylinderParams const & cyl,
                                                   render::vector const & axis_unit,
                                                   IntersectionParams const & params) {
-      render::vector rc       = r.origin - cyl.center;
+      render::vector rc       = r.orig - cyl.center;
       render::vector rc_perp  = perpendicular_component(rc, axis_unit);
-      render::vector dir_perp = perpendicular_component(r.direction, axis_unit);
+      render::vector dir_perp = perpendicular_component(r.dir, axis_unit);
 
       double a = render::dot(dir_perp, dir_perp);
       double b = 2.0 * render::dot(rc_perp, dir_perp);
@@ -107,7 +107,8 @@ namespace ray {
       HitRecord rec;
       rec.t                         = root;
       rec.point                     = point;
-      render::vector outward_normal = perpendicular_component(point - cyl.center, axis_unit);
+      render::vector outward_normal =
+          perpendicular_component(point - cyl.center, axis_unit) / cyl.radius;
       rec.set_face_normal(r, outward_normal);
       return rec;
     }
@@ -115,12 +116,12 @@ namespace ray {
     // Helper para probar intersección con una base del cilindro
     std::optional<HitRecord> hit_single_cap(Ray const & r, CapParams const & cap,
                                             IntersectionParams const & params) {
-      double denom = render::dot(r.direction, cap.normal);
+      double denom = render::dot(r.dir, cap.normal);
       if (std::abs(denom) <= 1e-8) {
         return std::nullopt;
       }
 
-      render::vector rp = cap.center - r.origin;
+      render::vector rp = cap.center - r.orig;
       double t          = render::dot(rp, cap.normal) / denom;
 
       if (t < params.t_min or t > params.t_max) {
@@ -0,0 +1,395 @@
+#include "../include/wavefront.hpp"
+
+#include "../../common/include/render_stats.hpp"
+#include "../include/ray_packet.hpp"
+#include "../include/ray_sort.hpp"
+#include "../include/soa_color.hpp"
+#include "../include/soa_ray.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+
+namespace soa {
+
+  namespace {
+
+    using render::real;
+
+    constexpr real NO_HIT = std::numeric_limits<real>::infinity();
+
+    // suma a su píxel el color final de un camino terminado
+    void finish_path(RowAccumulator & acc, std::uint32_t pixel, render::color_vector const & c) {
+      acc.r[pixel] += c.r();
+      acc.g[pixel] += c.g();
+      acc.b[pixel] += c.b();
+      acc.stats[pixel].add(render::luminance(c));
+      ++acc.taken[pixel];
+    }
+
+    // holgura relativa con la que se acepta el impacto recalculado en double frente al de float
+    constexpr double REFINE_TOLERANCE = 1e-3;
+
+    ray::Ray queue_ray(PathQueue const & q, std::size_t k) {
+      return {
+        render::vector{q.origin_x[k], q.origin_y[k], q.origin_z[k]},
+        render::vector{   q.dir_x[k],    q.dir_y[k],    q.dir_z[k]}
+      };
+    }
+
+    // impacto en double con una esfera o un cilindro de la escena antes de t_max
+    std::optional<ray::HitRecord> exact_hit(ray::Ray const & r, render::ObjectBase const & obj,
+                                            double t_max) {
+      ray::IntersectionParams const params{.t_min = ray::MIN_DISTANCE, .t_max = t_max};
+      if (obj.type == render::SPHERE_TYPE) {
+        auto const & sph = static_cast<Sphere const &>(obj);
+        return ray::hit_sphere(r, {sph.center_x, sph.center_y, sph.center_z}, sph.radius, params);
+      }
+      return ray::hit_cylinder(r, cylinder_params(static_cast<Cylinder const &>(obj)), params);
+    }
+
+    // guarda en el camino k el impacto con 'obj' (con la normal exterior)
+    void store_hit(PathQueue & q, std::size_t k, render::ObjectBase const & obj,
+                   ray::HitRecord const & rec) {
+      render::vector const outward = rec.front_face ? rec.normal : -rec.normal;
+      q.hit_t[k]                   = static_cast<real>(rec.t);
+      q.hit_object[k]              = &obj;
+      q.hit_material[k]            = obj.material_ptr;
+      q.normal_x[k]                = static_cast<real>(outward.get_x());
+      q.normal_y[k]                = static_cast<real>(outward.get_y());
+      q.normal_z[k]                = static_cast<real>(outward.get_z());
+    }
+
+    // impacto más cercano del camino k en double con toda la escena
+    void intersect_exact(PathQueue & q, std::size_t k, SceneOutput const & scene) {
+      ray::Ray const r  = queue_ray(q, k);
+      double closest    = std::numeric_limits<double>::infinity();
+      q.hit_t[k]        = NO_HIT;
+      q.hit_object[k]   = nullptr;
+      q.hit_material[k] = nullptr;
+      auto const test   = [&](render::ObjectBase const & obj) {
+        if (auto const rec = exact_hit(r, obj, closest)) {
+          closest = rec->t;
+          store_hit(q, k, obj, *rec);
+        }
+      };
+      std::ranges::for_each(scene.spheres.get(), test);
+      std::ranges::for_each(scene.cylinders.get(), test);
+    }
+
+    render::color_vector background(double dir_y, ConfigParams const & cfg) {
+      color::Color const light{cfg.background_light_color_r, cfg.background_light_color_g,
+                               cfg.background_light_color_b};
+      color::Color const dark{cfg.background_dark_color_r, cfg.background_dark_color_g,
+                              cfg.background_dark_color_b};
+      color::Color const c = color::background_color(dir_y, light, dark);
+      return {c.r, c.g, c.b};
+    }
+
+  }  // namespace
+
+  RowAccumulator::RowAccumulator(std::size_t width)
+      : r(width), g(width), b(width), stats(width), taken(width), segments(width),
+        active(width) { }
+
+  void RowAccumulator::reset() {
+    std::ranges::fill(r, 0.0);
+    std::ranges::fill(g, 0.0);
+    std::ranges::fill(b, 0.0);
+    std::ranges::fill(stats, render::RunningStats{});
+    std::ranges::fill(taken, 0U);
+    std::ranges::fill(segments, 0U);
+    std::ranges::fill(active, std::uint8_t{1});
+  }
+
+  WavefrontTracer::WavefrontTracer(WavefrontScene const & scene, std::size_t capacity)
+      : scene_(scene), queue_(capacity), sorter_(scene.scene, scene.view.origin, capacity),
+        batch_(capacity), identity_(capacity),
+        ray_rng_(static_cast<std::uint64_t>(scene.cfg.ray_rng_seed), scene.cfg.rng_engine),
+        material_rng_(static_cast<std::uint64_t>(scene.cfg.material_rng_seed),
+                      scene.cfg.rng_engine) {
+    std::iota(identity_.begin(), identity_.end(), 0U);
+  }
+
+  // --- generate ---
+
+  void WavefrontTracer::generate(int row, std::uint32_t samples, RowAccumulator const & acc) {
+    Viewport const & view = scene_.view;
+    bool const random     = scene_.sampler.type() == SamplerType::RANDOM;
+    PathQueue & q         = queue_;
+    row_                  = row;
+    q.size                = 0;
+    for (std::uint32_t i = 0; i < acc.active.size(); ++i) {
+      for (std::uint32_t s = 0; acc.active[i] != 0 and s < samples; ++s) {
+        render::SamplePoint const point{.x = static_cast<int>(i), .y = row,
+                                        .index = acc.taken[i] + s};
+        render::SampleStream stream = random ? render::SampleStream(ray_rng_)
+                                             : render::SampleStream(scene_.sampler, point);
+        double const px             = static_cast<double>(i) + stream.next();
+        double const py             = static_cast<double>(row) + stream.next();
+        render::vector const dir    = render::unit_vector(view.corner + px * view.step_x +
+                                                       py * view.step_y - view.origin);
+        std::size_t const k         = q.size++;
+        q.origin_x[k]               = static_cast<real>(view.origin.get_x());
+        q.origin_y[k]               = static_cast<real>(view.origin.get_y());
+        q.origin_z[k]               = static_cast<real>(view.origin.get_z());
+        q.dir_x[k]                  = static_cast<real>(dir.get_x());
+        q.dir_y[k]                  = static_cast<real>(dir.get_y());
+        q.dir_z[k]                  = static_cast<real>(dir.get_z());
+        q.weight_r[k]               = q.weight_g[k] = q.weight_b[k] = 1.0;
+        q.pixel[k]                  = i;
+        q.sample[k]                 = point.index;
+        q.dimension[k]              = stream.dimension();
+        q.depth[k]                  = 0;
+      }
+    }
+  }
+
+  void WavefrontTracer::trace(RowAccumulator & acc) {
+    bool primary = true;
+    while (queue_.size > 0) {
+      // los rayos de cámara ya salen ordenados por píxel
+      if (SORT_RAYS and !primary) {
+        sorter_.sort_for_intersect(queue_);
+      }
+      intersect(primary);
+      shade(acc);
+      queue_.compact();
+      extend();
+      primary = false;
+    }
+  }
+
+  // --- intersect ---
+
+  void WavefrontTracer::intersect(bool primary) {
+    PathQueue & q = queue_;
+    std::fill_n(q.hit_t.begin(), q.size, NO_HIT);
+    std::fill_n(q.hit_object.begin(), q.size, nullptr);
+    std::fill_n(q.hit_material.begin(), q.size, nullptr);
+    for (std::size_t k = 0; k < q.size; ++k) {
+      RENDER_STAT(render::thread_stats().count_ray(q.depth[k]));
+    }
+    if (primary and PACKET_WIDTH > 1) {
+      intersect_packets();
+    } else {
+      intersect_spheres(0, q.size);
+      intersect_cylinders(0, q.size);
+    }
+    if constexpr (render::SINGLE_PRECISION) {
+      refine_hits();
+    }
+  }
+
+  // rayos primarios en paquetes de PACKET_WIDTH; los que divergen y la cola final que no llena
+  // un paquete van rayo a rayo
+  void WavefrontTracer::intersect_packets() {
+    PathQueue & q     = queue_;
+    std::size_t begin = 0;
+    for (; begin + PACKET_WIDTH <= q.size; begin += PACKET_WIDTH) {
+      if (!intersect_packet<PACKET_WIDTH>(q, begin, scene_.scene)) {
+        intersect_spheres(begin, begin + PACKET_WIDTH);
+        intersect_cylinders(begin, begin + PACKET_WIDTH);
+      }
+    }
+    intersect_spheres(begin, q.size);
+    intersect_cylinders(begin, q.size);
+  }
+
+  // misma ecuación que ray::hit_sphere, escrita sobre las columnas (en render::real) para que
+  // el bucle interno no construya rayos ni registros
+  void WavefrontTracer::intersect_spheres(std::size_t begin, std::size_t end) {
+    PathQueue & q = queue_;
+    for (Sphere const & sph : scene_.scene.spheres.get()) {
+      real const radius = static_cast<real>(sph.radius);
+      real const r2     = radius * radius;
+      for (std::size_t k = begin; k < end; ++k) {
+        real const ocx    = q.origin_x[k] - static_cast<real>(sph.center_x);
+        real const ocy    = q.origin_y[k] - static_cast<real>(sph.center_y);
+        real const ocz    = q.origin_z[k] - static_cast<real>(sph.center_z);
+        real const a      = q.dir_x[k] * q.dir_x[k] + q.dir_y[k] * q.dir_y[k] +
+                       q.dir_z[k] * q.dir_z[k];
+        real const half_b = ocx * q.dir_x[k] + ocy * q.dir_y[k] + ocz * q.dir_z[k];
+        real const c      = ocx * ocx + ocy * ocy + ocz * ocz - r2;
+        real const disc   = half_b * half_b - a * c;
+        real root         = NO_HIT;
+        if (disc >= 0) {
+          real const sqrt_disc = std::sqrt(disc);
+          root                 = (-half_b - sqrt_disc) / a;
+          if (root <= ray::MIN_DISTANCE_REAL) {
+            root = (-half_b + sqrt_disc) / a;
+          }
+        }
+        bool const hit = root > ray::MIN_DISTANCE_REAL and root < q.hit_t[k];
+        RENDER_STAT(render::thread_stats().count_intersection(render::SPHERE_TYPE, hit));
+        RENDER_STAT(render::thread_stats().count_object(sph.source_line, hit));
+        if (hit) {
+          q.hit_t[k]        = root;
+          q.hit_object[k]   = &sph;
+          q.hit_material[k] = sph.material_ptr;
+          q.normal_x[k]     = (ocx + root * q.dir_x[k]) / radius;
+          q.normal_y[k]     = (ocy + root * q.dir_y[k]) / radius;
+          q.normal_z[k]     = (ocz + root * q.dir_z[k]) / radius;
+        }
+      }
+    }
+  }
+
+  void WavefrontTracer::intersect_cylinders(std::size_t begin, std::size_t end) {
+    PathQueue & q = queue_;
+    for (Cylinder const & cyl : scene_.scene.cylinders.get()) {
+      ray::CylinderParams const params = cylinder_params(cyl);
+      for (std::size_t k = begin; k < end; ++k) {
+        intersect_cylinder_lane(q, k, cyl, params);
+      }
+    }
+  }
+
+  // Modo RENDER_FLOAT: el impacto con la esfera encontrada en float se recalcula en double (la
+  // raíz frente a MIN_DISTANCE y la normal). Si en double no está cerca del de float (el
+  // redondeo ha encontrado la esfera de la que sale el rayo, o su raíz cercana) el camino se
+  // interseca otra vez en double con toda la escena. Los cilindros ya se prueban en double
+  void WavefrontTracer::refine_hits() {
+    PathQueue & q = queue_;
+    for (std::size_t k = 0; k < q.size; ++k) {
+      render::ObjectBase const * obj = q.hit_object[k];
+      if (obj == nullptr or obj->type != render::SPHERE_TYPE) {
+        continue;
+      }
+      double const t_max = q.hit_t[k] * (1.0 + REFINE_TOLERANCE) + ray::MIN_DISTANCE;
+      if (auto const rec = exact_hit(queue_ray(q, k), *obj, t_max)) {
+        store_hit(q, k, *obj, *rec);
+      } else {
+        intersect_exact(q, k, scene_.scene);
+      }
+    }
+  }
+
+  // --- shade ---
+
+  // Los caminos de un mismo material se dispersan juntos; los números aleatorios se sacan antes
+  // en el orden de la cola, de modo que cada camino recibe los mismos que con render::scatter
+  // rayo a rayo y la imagen no cambia
+  void WavefrontTracer::shade(RowAccumulator & acc) {
+    PathQueue & q = queue_;
+    shade_misses(acc);
+    std::span<std::uint32_t const> order = sorter_.bin_by_material(q);
+    if (order.empty()) {
+      order = std::span<std::uint32_t const>(identity_.data(), q.size);
+    }
+    // los caminos que van al fondo (clave 0) quedan al principio
+    std::size_t begin = 0;
+    while (begin < order.size() and q.hit_material[order[begin]] == nullptr) {
+      ++begin;
+    }
+    while (begin < order.size()) {
+      render::MaterialBase const * mat = q.hit_material[order[begin]];
+      std::size_t end                  = begin + 1;
+      while (end < order.size() and q.hit_material[order[end]] == mat) {
+        ++end;
+      }
+      std::span<std::uint32_t const> const run = order.subspan(begin, end - begin);
+      load_batch(run);
+      apply_batch(acc, run, render::scatter_batch(*mat, scene_.cfg.matte_scatter, batch_));
+      begin = end;
+    }
+  }
+
+  // en el orden de la cola: termina con el color del fondo los caminos sin impacto y saca los
+  // números de la dispersión de los que impactan
+  void WavefrontTracer::shade_misses(RowAccumulator & acc) {
+    PathQueue & q     = queue_;
+    bool const random = scene_.sampler.type() == SamplerType::RANDOM;
+    for (std::size_t k = 0; k < q.size; ++k) {
+      ++acc.segments[q.pixel[k]];
+      render::color_vector const weight(q.weight_r[k], q.weight_g[k], q.weight_b[k]);
+      if (q.hit_material[k] == nullptr) {
+        RENDER_STAT(++render::thread_stats().ray_misses);
+        render::vector const dir(q.dir_x[k], q.dir_y[k], q.dir_z[k]);
+        double const dir_y = q.dir_y[k] / dir.magnitude();
+        finish_path(acc, q.pixel[k], weight * background(dir_y, scene_.cfg));
+        q.alive[k] = 0;
+        continue;
+      }
+      RENDER_STAT(++render::thread_stats().ray_hits);
+      render::SamplePoint const point{.x = static_cast<int>(q.pixel[k]), .y = row_,
+                                      .index = q.sample[k]};
+      render::SampleStream stream = random ? render::SampleStream(material_rng_)
+                                           : render::SampleStream(scene_.sampler, point,
+                                                                  q.dimension[k]);
+      std::size_t const count     = render::scatter_uniforms(*q.hit_material[k],
+                                                             scene_.cfg.matte_scatter);
+      for (std::size_t u = 0; u < count; ++u) {
+        q.uniforms[u][k] = stream.next();
+      }
+      q.dimension[k] = stream.dimension();
+      q.alive[k]     = 1;
+    }
+  }
+
+  // copia al lote los caminos 'run' con la normal orientada como hit_record::set_face_normal
+  void WavefrontTracer::load_batch(std::span<std::uint32_t const> run) {
+    PathQueue const & q          = queue_;
+    render::ScatterBatch & batch = batch_;
+    batch.size                   = run.size();
+    for (std::size_t i = 0; i < run.size(); ++i) {
+      std::size_t const k = run[i];
+      double const cos_n  = q.dir_x[k] * q.normal_x[k] + q.dir_y[k] * q.normal_y[k] +
+                           q.dir_z[k] * q.normal_z[k];
+      bool const front    = cos_n < 0.0;
+      batch.dir_x[i]      = q.dir_x[k];
+      batch.dir_y[i]      = q.dir_y[k];
+      batch.dir_z[i]      = q.dir_z[k];
+      batch.normal_x[i]   = front ? q.normal_x[k] : -q.normal_x[k];
+      batch.normal_y[i]   = front ? q.normal_y[k] : -q.normal_y[k];
+      batch.normal_z[i]   = front ? q.normal_z[k] : -q.normal_z[k];
+      batch.front_face[i] = front ? 1 : 0;
+      for (std::size_t u = 0; u < render::MAX_SCATTER_UNIFORMS; ++u) {
+        batch.uniforms[u][i] = q.uniforms[u][k];
+      }
+    }
+  }
+
+  // escribe en la posición de cada camino que sigue el rayo dispersado (desde el punto de
+  // impacto) y la nueva atenuación acumulada; los absorbidos terminan sin luz
+  void WavefrontTracer::apply_batch(RowAccumulator & acc, std::span<std::uint32_t const> run,
+                                    render::color_vector const & attenuation) {
+    PathQueue & q                      = queue_;
+    render::ScatterBatch const & batch = batch_;
+    for (std::size_t i = 0; i < run.size(); ++i) {
+      std::size_t const k = run[i];
+      bool alive          = batch.bounced[i] != 0;
+      // el rayo dispersado sería el rebote número max_depth: el camino termina sin luz
+      if (alive and q.depth[k] + 1 >= scene_.cfg.max_depth) {
+        RENDER_STAT(++render::thread_stats().max_depth_terminations);
+        alive = false;
+      }
+      q.alive[k] = alive ? 1 : 0;
+      if (!alive) {
+        finish_path(acc, q.pixel[k], render::color_vector(0.0, 0.0, 0.0));
+        continue;
+      }
+      q.origin_x[k] += q.hit_t[k] * q.dir_x[k];
+      q.origin_y[k] += q.hit_t[k] * q.dir_y[k];
+      q.origin_z[k] += q.hit_t[k] * q.dir_z[k];
+      q.dir_x[k]     = static_cast<real>(batch.out_x[i]);
+      q.dir_y[k]     = static_cast<real>(batch.out_y[i]);
+      q.dir_z[k]     = static_cast<real>(batch.out_z[i]);
+      q.weight_r[k] *= attenuation.r();
+      q.weight_g[k] *= attenuation.g();
+      q.weight_b[k] *= attenuation.b();
+    }
+  }
+
+  // --- extend ---
+
+  void WavefrontTracer::extend() {
+    PathQueue & q = queue_;
+    for (std::size_t k = 0; k < q.size; ++k) {
+      ++q.depth[k];
+    }
+  }
+
+}  // namespace soa
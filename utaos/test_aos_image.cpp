@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+
+#include "alloc_counter.hpp"
+#include "aos_image.hpp"
+#include "tone_mapping.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// set_row cuantiza cada canal con la tabla y los intercala en los píxeles de la fila, sin
+// asignar memoria (los buffers de la fila se reservan al construir la imagen)
+TEST(test_aos_image, set_row_quantizes_without_allocating) {
+  constexpr int width = 5;
+  render::GammaLUT const lut(2.2);
+  std::vector<double> const r{0.0, 0.25, 0.5, 0.75, 1.0};
+  std::vector<double> const g{1.0, 0.75, 0.5, 0.25, 0.0};
+  std::vector<double> const b{-1.0, 0.1, 0.2, 0.3, 2.0};
+  aos::AOSImage image(width, 2);
+
+  render::AllocationCount const before = render::thread_allocations();
+  image.set_row(1, render::LinearRow{r, g, b}, lut);
+  render::AllocationCount const after = render::thread_allocations();
+
+  // sin ENABLE_ALLOC_COUNTING los dos recuentos son cero
+  EXPECT_EQ(after.allocations, before.allocations);
+  for (int x = 0; x < width; ++x) {
+    auto const i          = static_cast<std::size_t>(x);
+    aos::Pixel const & px = image.get_pixel(x, 1);
+    EXPECT_EQ(px.r, lut.to_byte(r[i])) << x;
+    EXPECT_EQ(px.g, lut.to_byte(g[i])) << x;
+    EXPECT_EQ(px.b, lut.to_byte(b[i])) << x;
+    EXPECT_EQ(image.get_pixel(x, 0).r, 0) << x;
+  }
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "alloc_counter.hpp"
+#include "aos_renderer.hpp"
+#include "cli_options.hpp"
+#include "config.hpp"
+#include "materials.hpp"
+#include "objects.hpp"
+#include "render_stats.hpp"
+#include "renderer.hpp"
+#include "scene_parser.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Render completo con el backend AOS (el bucle de filas de render_image) con el perfil por objeto
+// activo: la fase de render no debe asignar memoria dinámica
+TEST(test_aos_renderer, render_phase_does_not_allocate) {
+  if (!render::allocation_counting_enabled()) {
+    GTEST_SKIP() << "compilado con ENABLE_ALLOC_COUNTING=OFF";
+  }
+  std::vector<MatteMaterial> matte(1);
+  std::vector<MetalMaterial> metal(1);
+  std::vector<RefractiveMaterial> refractive(1);
+  refractive[0].refractive_index = 1.5;
+  std::vector<Sphere> spheres(2);
+  spheres[0].radius       = 1.0;
+  spheres[0].material_ptr = &matte[0];
+  spheres[0].source_line  = 1;
+  spheres[1].center_x     = -2.0;
+  spheres[1].radius       = 0.5;
+  spheres[1].material_ptr = &refractive[0];
+  spheres[1].source_line  = 2;
+  std::vector<Cylinder> cylinders(1);
+  cylinders[0].center_x     = 2.0;
+  cylinders[0].radius       = 0.5;
+  cylinders[0].axis_y       = 2.0;
+  cylinders[0].material_ptr = &metal[0];
+  cylinders[0].source_line  = 3;
+  SceneOutput const scene{matte, metal, refractive, spheres, cylinders};
+
+  ConfigParams config;
+  config.image_width       = 32;
+  config.samples_per_pixel = 4;
+  RenderOptions options;
+  options.output_file =
+      (std::filesystem::temp_directory_path() / "test_aos_renderer.ppm").string();
+  options.quiet = true;
+
+  render::AllocationProfile::instance().enable();
+  render::enable_object_profile(3);
+  render::RenderJob const job{.options    = options,
+                              .config     = config,
+                              .scene      = scene,
+                              .start_time = std::chrono::steady_clock::now()};
+  std::uint64_t primary_rays = 0;
+  ASSERT_TRUE(aos::AOSRenderer().render(job, primary_rays));
+  render::object_profile_active = false;
+  std::filesystem::remove(options.output_file);
+
+  EXPECT_EQ(primary_rays, 32U * 18U * 4U);
+  EXPECT_EQ(render::AllocationProfile::instance().category_total("render").allocations, 0U);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "alloc_counter.hpp"
+#include "hittable.hpp"
+#include "material_logic.hpp"
+#include "materials.hpp"
+#include "math_utilities.hpp"
+#include "objects.hpp"
+#include "ray.hpp"
+#include "trace.hpp"
+#include "vector.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+
+TEST(test_alloc_counter, counts_allocations_per_phase) {
+  if (!render::allocation_counting_enabled()) {
+    GTEST_SKIP() << "compilado con ENABLE_ALLOC_COUNTING=OFF";
+  }
+  auto & profile = render::AllocationProfile::instance();
+  profile.enable();
+  {
+    render::ScopedTimer const timer("alloc_phase", "alloc_test");
+    auto const value = std::make_unique<std::uint64_t>(7);
+    EXPECT_EQ(*value, 7U);
+  }
+  render::AllocationCount const total = profile.category_total("alloc_test");
+  EXPECT_EQ(total.allocations, 1U);
+  EXPECT_EQ(total.bytes, sizeof(std::uint64_t));
+
+  std::ostringstream out;
+  profile.write_report(out);
+  EXPECT_NE(out.str().find("alloc_phase"), std::string::npos);
+}
+
+// El camino caliente del render (intersección con la escena y dispersión en cada rebote) no debe
+// asignar memoria dinámica
+TEST(test_alloc_counter, render_kernels_do_not_allocate) {
+  if (!render::allocation_counting_enabled()) {
+    GTEST_SKIP() << "compilado con ENABLE_ALLOC_COUNTING=OFF";
+  }
+  MatteMaterial matte;
+  matte.reflectance_r = 0.5;
+  matte.reflectance_g = 0.5;
+  matte.reflectance_b = 0.5;
+  MetalMaterial metal;
+  metal.reflectance_r = 0.8;
+  metal.reflectance_g = 0.8;
+  metal.reflectance_b = 0.8;
+  metal.diffusion     = 0.1;
+  RefractiveMaterial glass;
+  glass.refractive_index = 1.5;
+
+  Sphere left;
+  left.center_x     = -1.0;
+  left.radius       = 0.8;
+  left.material_ptr = &matte;
+  Sphere right;
+  right.center_x     = 1.0;
+  right.radius       = 0.8;
+  right.material_ptr = &glass;
+  Cylinder floor;
+  floor.center_y     = -2.0;
+  floor.radius       = 1.5;
+  floor.axis_y       = 1.0;
+  floor.material_ptr = &metal;
+  render::hittable_list world;
+  world.add(&left);
+  world.add(&right);
+  world.add(&floor);
+
+  render::RNG rng(1);
+  render::color_vector attenuation;
+  render::ray scattered;
+  render::ScatterIO io{.attenuation = &attenuation, .scattered = &scattered, .rng = &rng};
+  render::AllocationCount const before = render::thread_allocations();
+  for (int i = 0; i < 1'000; ++i) {
+    render::point_vector const target(rng.random_double(-2.0, 2.0), rng.random_double(-2.0, 2.0),
+                                      0.0);
+    render::point_vector const origin(0.0, 0.0, -5.0);
+    render::ray r(origin, render::unit_vector(target - origin));
+    render::hit_record rec;
+    for (int depth = 0; depth < 8 and world.hit(r, 0.001, 1e9, rec); ++depth) {
+      if (!render::scatter(r, rec, io)) {
+        break;
+      }
+      r = scattered;
+    }
+  }
+  EXPECT_EQ(render::thread_allocations().allocations, before.allocations);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "block_rng.hpp"
+#include "config.hpp"
+#include "config_parser.hpp"
+#include "math_utilities.hpp"
+
+#include <array>
+#include <sstream>
+#include <vector>
+
+// valores de referencia de xoshiro256+ con la semilla 42 expandida con splitmix64 y el salto de
+// 2^128 pasos de Blackman y Vigna, calculados con una implementación independiente
+TEST(test_block_rng, matches_reference_xoshiro256_plus) {
+  render::BlockRNG rng(42);
+  std::array<double, 8> values{};
+  rng.fill(values);
+  // paso 1 de los carriles 0..3 (el carril i empieza i saltos después) y paso 2 del carril 0
+  EXPECT_EQ(values[0], 0x1.5f414253e3650p-4);
+  EXPECT_EQ(values[1], 0x1.4a10c0fd0a36ep-1);
+  EXPECT_EQ(values[2], 0x1.65a5043ee1100p-5);
+  EXPECT_EQ(values[3], 0x1.0fca9e07d2244p-1);
+  EXPECT_EQ(values[4], 0x1.3ddc7c23d0844p-2);
+
+  // tras jump() el carril 0 empieza LANES saltos después de la semilla
+  render::BlockRNG jumped(42);
+  jumped.jump();
+  std::array<double, render::BlockRNG::LANES> first{};
+  jumped.fill(first);
+  EXPECT_EQ(first[0], 0x1.436985aeb789cp-2);
+}
+
+TEST(test_block_rng, fills_uniform_doubles_and_floats) {
+  render::BlockRNG rng(7);
+  std::vector<double> doubles(10'001);
+  std::vector<float> floats(10'001);
+  rng.fill(doubles);
+  rng.fill(floats);
+  double double_sum = 0.0;
+  double float_sum  = 0.0;
+  for (std::size_t i = 0; i < doubles.size(); ++i) {
+    ASSERT_GE(doubles[i], 0.0);
+    ASSERT_LT(doubles[i], 1.0);
+    ASSERT_GE(floats[i], 0.0F);
+    ASSERT_LT(floats[i], 1.0F);
+    double_sum += doubles[i];
+    float_sum  += floats[i];
+  }
+  EXPECT_NEAR(double_sum / static_cast<double>(doubles.size()), 0.5, 0.01);
+  EXPECT_NEAR(float_sum / static_cast<double>(floats.size()), 0.5, 0.01);
+}
+
+TEST(test_block_rng, xoshiro_rng_resumes_sequence_and_is_configurable) {
+  // 100 números: el checkpoint cae en mitad de un bloque
+  render::RNG rng(42, RngEngine::XOSHIRO);
+  for (int i = 0; i < 100; ++i) {
+    (void) rng.random_double();
+  }
+  std::stringstream state;
+  rng.save_state(state);
+  render::RNG restored(7, RngEngine::XOSHIRO);
+  ASSERT_TRUE(restored.load_state(state));
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(restored.random_double(), rng.random_double());
+  }
+
+  ConfigParams config;
+  std::istringstream input("rng: xoshiro\n");
+  ASSERT_TRUE(parse_config(input, config));
+  EXPECT_EQ(config.rng_engine, RngEngine::XOSHIRO);
+  std::stringstream text;
+  write_config(text, config);
+  ConfigParams parsed;
+  ASSERT_TRUE(parse_config(text, parsed));
+  EXPECT_EQ(parsed, config);
+}
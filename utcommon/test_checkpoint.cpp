@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "accumulation_buffer.hpp"
+#include "checkpoint.hpp"
+#include "config.hpp"
+#include "config_parser.hpp"
+#include "math_utilities.hpp"
+
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+TEST(test_checkpoint, config_round_trip) {
+  ConfigParams config;
+  config.gamma         = 1.0 / 3.0;
+  config.camera_x      = -0.1;
+  config.field_of_view = 72.5;
+  std::stringstream text;
+  write_config(text, config);
+  ConfigParams parsed;
+  ASSERT_TRUE(parse_config(text, parsed));
+  EXPECT_EQ(parsed, config);
+}
+
+TEST(test_checkpoint, rng_resumes_sequence) {
+  render::RNG rng(42);
+  for (int i = 0; i < 100; ++i) {
+    (void) rng.random_double();
+  }
+  std::stringstream state;
+  rng.save_state(state);
+  render::RNG restored(7);
+  ASSERT_TRUE(restored.load_state(state));
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(restored.random_double(), rng.random_double());
+  }
+}
+
+TEST(test_checkpoint, save_and_load) {
+  ConfigParams config;
+  render::AccumulationBuffer buffer(4, 3);
+  buffer.add_sample(1, 2, render::color_vector(0.25, 0.5, 0.75));
+  buffer.add_samples(3, 0, render::color_vector(1.0, 2.0, 3.0), 4);
+  render::RNG ray_rng(1);
+  render::RNG material_rng(2);
+  (void) ray_rng.random_double();
+  std::string const filename =
+      (std::filesystem::temp_directory_path() / "test_checkpoint.ckpt").string();
+  ASSERT_TRUE(render::save_checkpoint(filename, {&config, &buffer, &ray_rng, &material_rng, 2}));
+
+  render::AccumulationBuffer loaded_buffer(4, 3);
+  render::RNG loaded_ray_rng(1);
+  render::RNG loaded_material_rng(2);
+  render::CheckpointData data{&config, &loaded_buffer, &loaded_ray_rng, &loaded_material_rng, 0};
+  ASSERT_TRUE(render::load_checkpoint(filename, data));
+  std::filesystem::remove(filename);
+
+  EXPECT_EQ(data.progress, 2);
+  EXPECT_EQ(loaded_buffer.sample_count(3, 0), 4U);
+  EXPECT_EQ(loaded_buffer.average(1, 2).g(), 0.5);
+  EXPECT_EQ(loaded_buffer.average(3, 0).b(), 0.75);
+  EXPECT_EQ(loaded_ray_rng.random_double(), ray_rng.random_double());
+}
+
+TEST(test_checkpoint, rejects_other_config) {
+  ConfigParams config;
+  render::AccumulationBuffer buffer(2, 2);
+  render::RNG ray_rng(1);
+  render::RNG material_rng(2);
+  std::string const filename =
+      (std::filesystem::temp_directory_path() / "test_checkpoint_config.ckpt").string();
+  ASSERT_TRUE(render::save_checkpoint(filename, {&config, &buffer, &ray_rng, &material_rng, 1}));
+
+  ConfigParams other = config;
+  other.samples_per_pixel += 1;
+  render::CheckpointData data{&other, &buffer, &ray_rng, &material_rng, 0};
+  EXPECT_FALSE(render::load_checkpoint(filename, data));
+  std::filesystem::remove(filename);
+}
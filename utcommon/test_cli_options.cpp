@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+
+#include "cli_options.hpp"
+
+#include <string>
+#include <vector>
+
+TEST(test_cli_options, parses_backend) {
+  std::vector<std::string> args{"render", "config.txt", "scene.txt", "out.ppm"};
+  RenderOptions defaults;
+  ASSERT_TRUE(parse_options(args, defaults));
+  EXPECT_FALSE(defaults.backend.has_value());
+
+  args.insert(args.end(), {"--backend", "soa"});
+  RenderOptions soa;
+  ASSERT_TRUE(parse_options(args, soa));
+  EXPECT_EQ(soa.backend, Backend::SOA);
+
+  args.back() = "aos";
+  RenderOptions aos;
+  ASSERT_TRUE(parse_options(args, aos));
+  EXPECT_EQ(aos.backend, Backend::AOS);
+
+  args.back() = "gpu";
+  RenderOptions invalid;
+  EXPECT_FALSE(parse_options(args, invalid));
+}
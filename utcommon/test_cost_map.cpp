@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "cost_map.hpp"
+#include "render_stats.hpp"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+TEST(test_cost_map, ramp_goes_from_black_to_white) {
+  EXPECT_EQ(render::CostMap::ramp(0.0), (std::array<std::uint8_t, 3>{0, 0, 0}));
+  EXPECT_EQ(render::CostMap::ramp(1.0), (std::array<std::uint8_t, 3>{255, 255, 255}));
+  EXPECT_EQ(render::CostMap::ramp(-1.0), render::CostMap::ramp(0.0));
+  EXPECT_EQ(render::CostMap::ramp(2.0), render::CostMap::ramp(1.0));
+}
+
+TEST(test_cost_map, counts_intersection_tests_per_pixel) {
+  if (!render::stats_enabled()) {
+    GTEST_SKIP() << "contadores de --stats no compilados";
+  }
+  render::CostMap map(2, 1, render::CostMap::Metric::TESTS);
+  std::uint64_t const start = map.probe();
+  render::thread_stats().count_intersection(render::SPHERE_TYPE, true);
+  render::thread_stats().count_intersection(render::CYLINDER_TYPE, false);
+  map.add(1, 0, start);
+  EXPECT_EQ(map.at(0, 0), 0U);
+  EXPECT_EQ(map.at(1, 0), 2U);
+  EXPECT_EQ(map.max_cost(), 2U);
+
+  std::string const filename =
+      (std::filesystem::temp_directory_path() / "test_cost_map.ppm").string();
+  ASSERT_TRUE(map.write_ppm(filename, false));
+  std::ifstream in(filename, std::ios::binary);
+  std::string const data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  std::filesystem::remove(filename);
+  EXPECT_EQ(data, std::string("P6\n2 1\n255\n") + std::string(3, '\0') + std::string(3, '\xff'));
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include "hittable.hpp"
+#include "materials.hpp"
+#include "math_utilities.hpp"
+#include "objects.hpp"
+#include "ray.hpp"
+#include "vector.hpp"
+
+#include <array>
+
+TEST(test_hittable, float_vector_matches_double) {
+  render::vector const u{1.0, 2.0, 3.0};
+  render::vector const v{-0.5, 4.0, 0.25};
+  auto const uf = render::vector_cast<float>(u);
+  auto const vf = render::vector_cast<float>(v);
+  EXPECT_FLOAT_EQ(render::dot(uf, vf), static_cast<float>(render::dot(u, v)));
+  render::basic_vector<float> const c = render::cross(uf, vf);
+  render::vector const expected       = render::cross(u, v);
+  EXPECT_FLOAT_EQ(c.get_x(), static_cast<float>(expected.get_x()));
+  EXPECT_FLOAT_EQ(c.get_y(), static_cast<float>(expected.get_y()));
+  EXPECT_FLOAT_EQ(c.get_z(), static_cast<float>(expected.get_z()));
+  EXPECT_FLOAT_EQ(render::unit_vector(uf).magnitude(), 1.0F);
+  EXPECT_TRUE(render::basic_vector<float>(1e-9F, 0.0F, -1e-9F).near_zero());
+}
+
+// la búsqueda en float con el impacto recalculado en double da el mismo impacto que la búsqueda
+// en double, también con rayos que salen de la superficie de un objeto (rebotes)
+TEST(test_hittable, refined_hit_matches_double_search) {
+  MatteMaterial matte;
+  Sphere left;
+  left.center_x     = -1.0;
+  left.radius       = 0.8;
+  left.material_ptr = &matte;
+  Sphere right;
+  right.center_x     = 1.0;
+  right.center_z     = 0.5;
+  right.radius       = 0.6;
+  right.material_ptr = &matte;
+  Cylinder floor;
+  floor.center_y     = -2.0;
+  floor.radius       = 1.5;
+  floor.axis_y       = 1.0;
+  floor.material_ptr = &matte;
+  render::hittable_list world;
+  world.add(&left);
+  world.add(&right);
+  world.add(&floor);
+
+  render::RNG rng(3);
+  for (int i = 0; i < 2'000; ++i) {
+    render::point_vector const target(rng.random_double(-2.0, 2.0), rng.random_double(-3.0, 1.0),
+                                      0.0);
+    render::point_vector const origin(0.0, 0.0, -5.0);
+    render::ray r(origin, render::unit_vector(target - origin));
+    for (int depth = 0; depth < 4; ++depth) {
+      render::hit_record exact;
+      render::hit_record refined;
+      bool const hit = world.hit(r, 0.001, 1e9, exact);
+      ASSERT_EQ(world.hit_refined(r, 0.001, 1e9, refined), hit) << i;
+      if (!hit) {
+        break;
+      }
+      EXPECT_EQ(refined.t, exact.t) << i;
+      EXPECT_EQ(refined.normal.get_x(), exact.normal.get_x()) << i;
+      EXPECT_EQ(refined.normal.get_y(), exact.normal.get_y()) << i;
+      EXPECT_EQ(refined.normal.get_z(), exact.normal.get_z()) << i;
+      EXPECT_EQ(refined.mat_pointer, exact.mat_pointer) << i;
+      r = render::ray(exact.intersect, render::unit_vector(render::random_vec(rng)));
+    }
+  }
+}
+
+// rayos que pasan lejos de una esfera y de un cilindro no los tocan (el término cuadrático usa
+// la longitud al cuadrado, no la longitud)
+TEST(test_hittable, clear_misses_do_not_hit) {
+  MatteMaterial matte;
+  Sphere sphere;
+  sphere.radius       = 1.0;
+  sphere.material_ptr = &matte;
+  Cylinder cylinder;
+  cylinder.center_x     = 2.0;
+  cylinder.radius       = 0.5;
+  cylinder.axis_y       = 2.0;
+  cylinder.material_ptr = &matte;
+  render::hittable_list world;
+  world.add(&sphere);
+  world.add(&cylinder);
+
+  render::direction_vector const forward(0.0, 0.0, 1.0);
+  render::hit_record rec;
+  // a 3 unidades del centro de la esfera, y a 2 del eje del cilindro
+  EXPECT_FALSE(world.hit(render::ray({0.0, 3.0, -5.0}, forward), 0.001, 1e9, rec));
+  EXPECT_FALSE(world.hit(render::ray({4.0, 0.0, -5.0}, forward), 0.001, 1e9, rec));
+  // por encima de la tapa superior del cilindro (altura 2: tapas en y = ±1)
+  EXPECT_FALSE(world.hit(render::ray({2.0, 1.5, -5.0}, forward), 0.001, 1e9, rec));
+}
+
+// impactos con t y normal calculados a mano, con la búsqueda en double y con la de float
+// refinada en double: esfera de radio 1 en el origen y cilindro de radio 0.5 y altura 2
+TEST(test_hittable, hits_match_analytic_solution) {
+  MatteMaterial matte;
+  Sphere sphere;
+  sphere.radius       = 1.0;
+  sphere.material_ptr = &matte;
+  Cylinder cylinder;
+  cylinder.center_x     = 2.0;
+  cylinder.radius       = 0.5;
+  cylinder.axis_y       = 2.0;
+  cylinder.material_ptr = &matte;
+  render::hittable_list world;
+  world.add(&sphere);
+  world.add(&cylinder);
+
+  struct Expected {
+    render::ray r;
+    double t;
+    render::normal_vector normal;
+  };
+  std::array<Expected, 3> const cases{
+    // esfera a x = 0.6: entra en z = -0.8
+    Expected{render::ray({0.6, 0.0, -5.0}, {0.0, 0.0, 1.0}), 4.2, {0.6, 0.0, -0.8}},
+    // superficie lateral del cilindro a x = 2.3: entra en z = -0.4
+    Expected{render::ray({2.3, 0.2, -5.0}, {0.0, 0.0, 1.0}), 4.6, {0.6, 0.0, -0.8}},
+    // tapa superior del cilindro (y = 1) desde arriba
+    Expected{render::ray({2.1, 5.0, 0.0}, {0.0, -1.0, 0.0}), 4.0, {0.0, 1.0, 0.0}},
+  };
+  for (Expected const & expected : cases) {
+    render::hit_record exact;
+    render::hit_record refined;
+    ASSERT_TRUE(world.hit(expected.r, 0.001, 1e9, exact));
+    ASSERT_TRUE(world.hit_refined(expected.r, 0.001, 1e9, refined));
+    for (render::hit_record const & rec : {exact, refined}) {
+      EXPECT_NEAR(rec.t, expected.t, 1e-12);
+      EXPECT_NEAR(rec.normal.get_x(), expected.normal.get_x(), 1e-12);
+      EXPECT_NEAR(rec.normal.get_y(), expected.normal.get_y(), 1e-12);
+      EXPECT_NEAR(rec.normal.get_z(), expected.normal.get_z(), 1e-12);
+    }
+  }
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "config.hpp"
+#include "config_parser.hpp"
+#include "hit_record.hpp"
+#include "material_logic.hpp"
+#include "materials.hpp"
+#include "math_utilities.hpp"
+#include "ray.hpp"
+#include "vector.hpp"
+
+#include <sstream>
+
+TEST(test_material_logic, cosine_hemisphere_follows_the_normal) {
+  render::RNG rng(7);
+  for (render::normal_vector const normal :
+       {render::vector(0.0, 0.0, 1.0), render::vector(0.0, 0.0, -1.0),
+        render::unit_vector(render::vector(1.0, -2.0, 0.5))})
+  {
+    // media de cos(theta) con densidad cos(theta) / pi: 2/3
+    constexpr int SAMPLES = 20'000;
+    double cos_sum        = 0.0;
+    for (int i = 0; i < SAMPLES; ++i) {
+      double const u1                  = rng.random_double();
+      render::direction_vector const d = render::cosine_hemisphere(normal, u1, rng.random_double());
+      EXPECT_NEAR(d.magnitude_squared(), 1.0, 1e-12);
+      ASSERT_GT(render::dot(d, normal), 0.0);
+      cos_sum += render::dot(d, normal);
+    }
+    EXPECT_NEAR(cos_sum / SAMPLES, 2.0 / 3.0, 0.01);
+  }
+}
+
+TEST(test_material_logic, matte_scatter_mode_is_selectable) {
+  render::hit_record rec;
+  rec.intersect = render::vector(1.0, 2.0, 3.0);
+  rec.normal    = render::vector(0.0, 1.0, 0.0);
+  MatteMaterial mat;
+  mat.reflectance_r = 0.5;
+  mat.reflectance_g = 0.25;
+  mat.reflectance_b = 1.0;
+  render::RNG rng(3);
+  render::color_vector attenuation;
+  render::ray scattered;
+  render::ScatterIO io{.attenuation   = &attenuation,
+                       .scattered     = &scattered,
+                       .rng           = &rng,
+                       .samples       = nullptr,
+                       .matte_scatter = MatteScatter::COSINE};
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(render::scatter_matte(rec, &mat, io));
+    EXPECT_GT(scattered.dir.get_y(), 0.0);
+    EXPECT_EQ(attenuation.g(), 0.25);
+  }
+
+  ConfigParams config;
+  std::istringstream input("mattescatter: cosine\n");
+  ASSERT_TRUE(parse_config(input, config));
+  EXPECT_EQ(config.matte_scatter, MatteScatter::COSINE);
+  std::stringstream text;
+  write_config(text, config);
+  ConfigParams parsed;
+  ASSERT_TRUE(parse_config(text, parsed));
+  EXPECT_EQ(parsed, config);
+}
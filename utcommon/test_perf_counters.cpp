@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include "perf_counters.hpp"
+#include "trace.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Con o sin contadores hardware disponibles, las fases del hilo que abrió los contadores
+// aparecen en el informe y las de otros hilos no
+TEST(test_perf_counters, reports_phases_of_opening_thread) {
+  auto & counters = render::PerfCounters::instance();
+  bool const any  = counters.open();
+  {
+    render::ScopedTimer const timer("perf_phase", "test");
+  }
+  std::thread worker([] { render::ScopedTimer const timer("perf_worker_phase", "test"); });
+  worker.join();
+
+  std::ostringstream out;
+  counters.write_report(out, 1000);
+  std::string const text = out.str();
+  EXPECT_NE(text.find("1000 rayos primarios"), std::string::npos);
+  EXPECT_NE(text.find("perf_phase"), std::string::npos);
+  EXPECT_EQ(text.find("perf_worker_phase"), std::string::npos);
+  if (!any) {
+    EXPECT_NE(text.find("n/d"), std::string::npos);
+  }
+}
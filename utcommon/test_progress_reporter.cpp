@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include "progress_reporter.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(test_progress_reporter, counts_work_from_several_threads) {
+  render::ProgressReporter progress(400, "filas", true);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < 4; ++t) {
+    workers.emplace_back([&progress] {
+      for (int row = 0; row < 50; ++row) {
+        progress.advance(1, 100);
+      }
+    });
+  }
+  for (std::thread & worker : workers) {
+    worker.join();
+  }
+  EXPECT_EQ(progress.done(), 200U);
+  EXPECT_EQ(progress.rays(), 20'000U);
+
+  std::ostringstream out;
+  progress.write_line(out);
+  std::string const line = out.str();
+  EXPECT_TRUE(line.starts_with("\rProgreso: 50.0% (200/400 filas)"));
+  EXPECT_NE(line.find("Mrayos/s"), std::string::npos);
+  EXPECT_NE(line.find("ETA"), std::string::npos);
+}
+
+TEST(test_progress_reporter, unknown_total_has_no_eta) {
+  render::ProgressReporter progress(0, "filas", true);
+  progress.advance(3, 30);
+  std::ostringstream out;
+  progress.write_line(out);
+  EXPECT_TRUE(out.str().starts_with("\rProgreso: 3 filas"));
+  EXPECT_EQ(out.str().find("ETA"), std::string::npos);
+}
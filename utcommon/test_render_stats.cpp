@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "geometry_logic.hpp"
+#include "objects.hpp"
+#include "ray.hpp"
+#include "render_stats.hpp"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+TEST(test_render_stats, merge_and_json) {
+  render::RenderStats a;
+  a.count_ray(0);
+  a.count_ray(2);
+  a.count_intersection(render::CYLINDER_TYPE, true);
+  render::RenderStats b;
+  b.count_ray(0);
+  b.count_scatter(render::METAL_TYPE, false);
+  b.max_depth_terminations = 3;
+  a.merge(b);
+
+  EXPECT_EQ(a.primary_rays, 2U);
+  EXPECT_EQ(a.secondary_rays[2], 1U);
+  EXPECT_EQ(a.intersection_hits[render::CYLINDER_TYPE], 1U);
+  EXPECT_EQ(a.absorbed[render::METAL_TYPE], 1U);
+
+  std::ostringstream json;
+  a.write_json(json);
+  EXPECT_NE(json.str().find("\"secondary_rays_by_depth\": [0, 1]"), std::string::npos);
+  EXPECT_NE(json.str().find("\"max_depth_terminations\": 3"), std::string::npos);
+}
+
+TEST(test_render_stats, collects_finished_threads) {
+  if (!render::stats_enabled()) {
+    GTEST_SKIP() << "compilado con ENABLE_RENDER_STATS=OFF";
+  }
+  Sphere sph;
+  sph.radius = 1.0;
+  render::ray const r({0.0, 0.0, -5.0}, {0.0, 0.0, 1.0});
+  std::uint64_t const before = render::collect_stats().intersection_tests[render::SPHERE_TYPE];
+
+  // los contadores de un hilo ya terminado se conservan en el total
+  std::thread worker([&] {
+    render::hit_record rec;
+    (void) render::hit_object(r, std::array<double, 2>{0.001, 100.0}, rec, &sph);
+  });
+  worker.join();
+  render::hit_record rec;
+  (void) render::hit_object(r, std::array<double, 2>{0.001, 100.0}, rec, &sph);
+
+  EXPECT_EQ(render::collect_stats().intersection_tests[render::SPHERE_TYPE], before + 2);
+}
+
+TEST(test_render_stats, object_profile_by_scene_line) {
+  if (!render::stats_enabled()) {
+    GTEST_SKIP() << "compilado con ENABLE_RENDER_STATS=OFF";
+  }
+  std::string const scene_file =
+      (std::filesystem::temp_directory_path() / "test_object_profile.txt").string();
+  {
+    std::ofstream scene(scene_file);
+    scene << "matte: m 0.5 0.5 0.5\nsphere: 0 0 0 1 m\nsphere: 0 0 40 1 m\n";
+  }
+  Sphere hit_sph;
+  hit_sph.radius      = 1.0;
+  hit_sph.source_line = 2;
+  Sphere far_sph;
+  far_sph.center_y    = 40.0;
+  far_sph.radius      = 1.0;
+  far_sph.source_line = 3;
+  render::ray const r({0.0, 0.0, -5.0}, {0.0, 0.0, 1.0});
+  render::hit_record rec;
+
+  // desactivado no cuenta nada; activado cuenta por línea de escena
+  (void) render::hit_object(r, std::array<double, 2>{0.001, 100.0}, rec, &hit_sph);
+  EXPECT_TRUE(render::collect_stats().object_counts.empty());
+  render::enable_object_profile(far_sph.source_line);
+  for (int i = 0; i < 2; ++i) {
+    (void) render::hit_object(r, std::array<double, 2>{0.001, 100.0}, rec, &hit_sph);
+  }
+  (void) render::hit_object(r, std::array<double, 2>{0.001, 100.0}, rec, &far_sph);
+  render::object_profile_active = false;
+
+  std::ostringstream out;
+  render::write_object_profile(out, scene_file, 1);
+  std::filesystem::remove(scene_file);
+  std::string const text = out.str();
+  EXPECT_NE(text.find("(1 de 2 objetos, 3 pruebas)"), std::string::npos);
+  EXPECT_NE(text.find("sphere: 0 0 0 1 m"), std::string::npos);
+  EXPECT_EQ(text.find("sphere: 0 0 40 1 m"), std::string::npos);
+}
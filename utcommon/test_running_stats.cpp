@@ -0,0 +1,22 @@
+#include <gtest/gtest.h>
+
+#include "running_stats.hpp"
+
+TEST(test_running_stats, mean_and_variance) {
+  render::RunningStats stats;
+  for (double const value : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}) {
+    stats.add(value);
+  }
+  EXPECT_EQ(stats.count(), 8);
+  EXPECT_DOUBLE_EQ(stats.mean(), 5.0);
+  EXPECT_DOUBLE_EQ(stats.variance(), 32.0 / 7.0);
+}
+
+TEST(test_running_stats, converges_on_constant_signal) {
+  render::RunningStats stats;
+  stats.add(0.5);
+  stats.add(0.5);
+  EXPECT_TRUE(stats.converged(0.01));
+  stats.add(1.5);
+  EXPECT_FALSE(stats.converged(0.01));
+}
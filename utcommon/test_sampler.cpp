@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include "config.hpp"
+#include "config_parser.hpp"
+#include "math_utilities.hpp"
+#include "sampler.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+  // cuenta cuántas de las primeras n muestras de la dimensión caen en cada uno de n intervalos
+  std::vector<int> strata(render::Sampler const & sampler, std::uint32_t n,
+                          std::uint32_t dimension) {
+    std::vector<int> hits(n, 0);
+    for (std::uint32_t i = 0; i < n; ++i) {
+      double const value = sampler.get({.x = 3, .y = 7, .index = i}, dimension);
+      EXPECT_GE(value, 0.0);
+      EXPECT_LT(value, 1.0);
+      ++hits[static_cast<std::size_t>(value * n)];
+    }
+    return hits;
+  }
+
+}  // namespace
+
+TEST(test_sampler, sobol_and_halton_stratify_each_dimension) {
+  render::Sampler const sobol(SamplerType::SOBOL, 19);
+  render::Sampler const halton(SamplerType::HALTON, 19);
+  std::vector<int> const once(64, 1);
+  for (std::uint32_t dimension : {0U, 1U, 5U}) {
+    EXPECT_EQ(strata(sobol, 64, dimension), once) << "sobol, dimensión " << dimension;
+  }
+  EXPECT_EQ(strata(halton, 64, 0), once);
+  EXPECT_EQ(strata(halton, 27, 1), std::vector<int>(27, 1));
+}
+
+TEST(test_sampler, values_depend_only_on_pixel_sample_and_dimension) {
+  for (SamplerType type : {SamplerType::HALTON, SamplerType::SOBOL, SamplerType::BLUE_NOISE}) {
+    render::Sampler const a(type, 5);
+    render::Sampler const b(type, 5);
+    render::SamplePoint const point{.x = 10, .y = 2, .index = 9};
+    EXPECT_EQ(a.get(point, 4), b.get(point, 4));
+    EXPECT_NE(a.get(point, 4), a.get({.x = 11, .y = 2, .index = 9}, 4));
+    EXPECT_NE(a.get(point, 4), a.get(point, 5));
+  }
+}
+
+// SampleStream guarda la semilla del píxel: sus números son los de get() dimensión a dimensión
+TEST(test_sampler, stream_matches_get) {
+  for (SamplerType type : {SamplerType::HALTON, SamplerType::SOBOL, SamplerType::BLUE_NOISE}) {
+    render::Sampler const sampler(type, 5);
+    render::SamplePoint const point{.x = 4, .y = 9, .index = 13};
+    render::SampleStream stream(sampler, point, 2);
+    for (std::uint32_t dimension = 2; dimension < 40; ++dimension) {
+      EXPECT_EQ(stream.next(), sampler.get(point, dimension)) << dimension;
+    }
+  }
+}
+
+TEST(test_sampler, blue_noise_mask_is_a_permutation_of_ranks) {
+  auto const & mask = render::BlueNoiseMask::instance();
+  std::vector<std::uint16_t> ranks;
+  for (int y = 0; y < render::BlueNoiseMask::SIZE; ++y) {
+    for (int x = 0; x < render::BlueNoiseMask::SIZE; ++x) {
+      ranks.push_back(mask.rank(x, y));
+    }
+  }
+  std::ranges::sort(ranks);
+  for (std::size_t i = 0; i < ranks.size(); ++i) {
+    ASSERT_EQ(ranks[i], i);
+  }
+  // el tile se repite
+  EXPECT_EQ(mask.rank(-1, 0), mask.rank(render::BlueNoiseMask::SIZE - 1, 0));
+}
+
+TEST(test_sampler, rng_stream_repeats_the_generator) {
+  render::RNG rng(42);
+  render::RNG reference(42);
+  render::SampleStream stream(rng);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(stream.next(-2.0, 3.0), reference.random_double(-2.0, 3.0));
+  }
+}
+
+TEST(test_sampler, config_key_round_trip) {
+  ConfigParams config;
+  std::istringstream input("sampler: bluenoise\n");
+  ASSERT_TRUE(parse_config(input, config));
+  EXPECT_EQ(config.sampler, SamplerType::BLUE_NOISE);
+
+  std::stringstream text;
+  write_config(text, config);
+  ConfigParams parsed;
+  ASSERT_TRUE(parse_config(text, parsed));
+  EXPECT_EQ(parsed, config);
+
+  std::istringstream bad("sampler: stratified\n");
+  EXPECT_FALSE(parse_config(bad, parsed));
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "hit_record.hpp"
+#include "material_logic.hpp"
+#include "materials.hpp"
+#include "math_utilities.hpp"
+#include "ray.hpp"
+#include "scatter_batch.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+  constexpr std::size_t BATCH_SIZE     = 200;
+  constexpr std::uint64_t UNIFORM_SEED = 5;
+
+  // impactos con dirección y normal aleatorias (por delante y por detrás) y los números
+  // uniformes que consumirá cada uno, sacados en orden de un RNG con UNIFORM_SEED
+  struct BatchCase {
+    std::vector<render::ray> incoming;
+    std::vector<render::hit_record> records;
+    render::ScatterBatch batch{BATCH_SIZE};
+  };
+
+  BatchCase make_case(std::size_t uniforms) {
+    render::RNG rng(11);
+    render::RNG uniform_rng(UNIFORM_SEED);
+    BatchCase c;
+    c.batch.size = BATCH_SIZE;
+    for (std::size_t k = 0; k < BATCH_SIZE; ++k) {
+      render::ray const r(render::random_vec(rng), render::random_vec(rng));
+      render::hit_record rec;
+      rec.t         = rng.random_double();
+      rec.intersect = r.at(rec.t);
+      rec.set_face_normal(r, render::unit_vector(render::random_vec(rng)));
+      c.batch.dir_x[k]      = r.dir.get_x();
+      c.batch.dir_y[k]      = r.dir.get_y();
+      c.batch.dir_z[k]      = r.dir.get_z();
+      c.batch.normal_x[k]   = rec.normal.get_x();
+      c.batch.normal_y[k]   = rec.normal.get_y();
+      c.batch.normal_z[k]   = rec.normal.get_z();
+      c.batch.front_face[k] = rec.front_face ? 1 : 0;
+      for (std::size_t u = 0; u < uniforms; ++u) {
+        c.batch.uniforms[u][k] = uniform_rng.random_double();
+      }
+      c.incoming.push_back(r);
+      c.records.push_back(rec);
+    }
+    return c;
+  }
+
+  // render::scatter rayo a rayo, con un RNG que repite los números del lote, debe dar la misma
+  // dirección bit a bit
+  void expect_same_as_scatter(BatchCase & c, render::MaterialBase const & mat,
+                              MatteScatter matte_scatter) {
+    render::color_vector const batch_attenuation =
+        render::scatter_batch(mat, matte_scatter, c.batch);
+    render::RNG rng(UNIFORM_SEED);
+    for (std::size_t k = 0; k < BATCH_SIZE; ++k) {
+      render::hit_record rec = c.records[k];
+      rec.mat_pointer        = &mat;
+      render::color_vector attenuation;
+      render::ray scattered;
+      render::ScatterIO io{.attenuation   = &attenuation,
+                           .scattered     = &scattered,
+                           .rng           = &rng,
+                           .samples       = nullptr,
+                           .matte_scatter = matte_scatter};
+      bool const bounced = render::scatter(c.incoming[k], rec, io);
+      ASSERT_EQ(bounced, c.batch.bounced[k] != 0) << k;
+      EXPECT_EQ(scattered.dir.get_x(), c.batch.out_x[k]) << k;
+      EXPECT_EQ(scattered.dir.get_y(), c.batch.out_y[k]) << k;
+      EXPECT_EQ(scattered.dir.get_z(), c.batch.out_z[k]) << k;
+      EXPECT_EQ(attenuation.r(), batch_attenuation.r());
+      EXPECT_EQ(attenuation.g(), batch_attenuation.g());
+      EXPECT_EQ(attenuation.b(), batch_attenuation.b());
+    }
+  }
+
+}  // namespace
+
+TEST(test_scatter_batch, matte_matches_scatter) {
+  MatteMaterial mat;
+  mat.reflectance_r = 0.5;
+  mat.reflectance_g = 0.25;
+  mat.reflectance_b = 1.0;
+  for (MatteScatter const mode : {MatteScatter::CUBE, MatteScatter::COSINE}) {
+    BatchCase c = make_case(render::scatter_uniforms(mat, mode));
+    expect_same_as_scatter(c, mat, mode);
+  }
+}
+
+TEST(test_scatter_batch, metal_matches_scatter) {
+  MetalMaterial mat;
+  mat.reflectance_r = mat.reflectance_g = mat.reflectance_b = 0.8;
+  mat.diffusion     = 0.4;
+  BatchCase c       = make_case(render::scatter_uniforms(mat, MatteScatter::CUBE));
+  expect_same_as_scatter(c, mat, MatteScatter::CUBE);
+  // con esta difusión parte de los rayos entra en la superficie y se absorbe
+  EXPECT_TRUE(std::ranges::find(c.batch.bounced, std::uint8_t{0}) != c.batch.bounced.end());
+}
+
+TEST(test_scatter_batch, refractive_matches_scatter) {
+  RefractiveMaterial mat;
+  mat.refractive_index = 1.5;
+  BatchCase c          = make_case(render::scatter_uniforms(mat, MatteScatter::CUBE));
+  expect_same_as_scatter(c, mat, MatteScatter::CUBE);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "accumulation_buffer.hpp"
+#include "snapshot_writer.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+  std::string read_file(std::string const & filename) {
+    std::ifstream in(filename, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  }
+
+}  // namespace
+
+TEST(test_snapshot_writer, writes_latest_buffer) {
+  std::string const filename =
+      (std::filesystem::temp_directory_path() / "test_snapshot.ppm").string();
+  render::AccumulationBuffer buffer(2, 2);
+  buffer.add_sample(0, 0, render::color_vector(1.0, 0.0, 0.0));
+  {
+    render::SnapshotWriter writer(filename, 1.0, false);
+    writer.submit(buffer);
+    buffer.add_sample(1, 1, render::color_vector(0.0, 0.0, 1.0));
+    writer.submit(buffer);
+    writer.finish();
+    EXPECT_GE(writer.written(), 1);
+  }
+  std::string const header = "P6\n2 2\n255\n";
+  std::string const data   = read_file(filename);
+  std::filesystem::remove(filename);
+
+  ASSERT_EQ(data.size(), header.size() + 12);
+  EXPECT_EQ(data.substr(0, header.size()), header);
+  std::vector<unsigned char> const pixels(data.begin() + static_cast<long>(header.size()),
+                                          data.end());
+  // la última copia enviada es la que queda escrita
+  EXPECT_EQ(pixels, (std::vector<unsigned char>{255, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 255}));
+}
+
+TEST(test_snapshot_writer, last_row_first) {
+  std::string const filename =
+      (std::filesystem::temp_directory_path() / "test_snapshot_flip.ppm").string();
+  render::AccumulationBuffer buffer(1, 2);
+  buffer.add_sample(0, 1, render::color_vector(1.0, 1.0, 1.0));
+  {
+    render::SnapshotWriter writer(filename, 2.2, true);
+    writer.submit(buffer);
+  }
+  std::string const data = read_file(filename);
+  std::filesystem::remove(filename);
+
+  ASSERT_EQ(data.size(), 11U + 6U);
+  EXPECT_EQ(static_cast<unsigned char>(data[11]), 255);
+  EXPECT_EQ(static_cast<unsigned char>(data[14]), 0);
+}
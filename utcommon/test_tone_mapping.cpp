@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "tone_mapping.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace {
+
+  // referencia: la conversión escalar que usaban SOAImage::to_byte y render-aos
+  int exact_byte(double value, double gamma) {
+    double const clamped = std::clamp(value, 0.0, 1.0);
+    return static_cast<int>(std::pow(clamped, 1.0 / gamma) * 255.0);
+  }
+
+}  // namespace
+
+TEST(test_tone_mapping, error_at_most_one_lsb) {
+  for (double const gamma : {1.0, 1.8, 2.2, 2.4, 3.0}) {
+    render::GammaLUT const lut(gamma);
+    int max_error = 0;
+    for (int i = 0; i <= 1'000'000; ++i) {
+      double const value = static_cast<double>(i) / 1'000'000.0;
+      max_error = std::max(max_error, std::abs(lut.to_byte(value) - exact_byte(value, gamma)));
+    }
+    EXPECT_LE(max_error, 1) << "gamma " << gamma;
+  }
+}
+
+TEST(test_tone_mapping, saturates_out_of_range) {
+  render::GammaLUT const lut(2.2);
+  EXPECT_EQ(lut.to_byte(-0.5), 0);
+  EXPECT_EQ(lut.to_byte(0.0), 0);
+  EXPECT_EQ(lut.to_byte(1.0), 255);
+  EXPECT_EQ(lut.to_byte(7.0), 255);
+  EXPECT_EQ(lut.to_byte(std::numeric_limits<double>::quiet_NaN()), 0);
+}
+
+TEST(test_tone_mapping, quantize_matches_scalar) {
+  render::GammaLUT const lut(2.2);
+  std::vector<double> linear(1'000);
+  for (std::size_t i = 0; i < linear.size(); ++i) {
+    linear[i] = static_cast<double>(i) / 900.0 - 0.05;
+  }
+  std::vector<std::uint8_t> bytes(linear.size());
+  lut.quantize(linear, bytes);
+  for (std::size_t i = 0; i < linear.size(); ++i) {
+    EXPECT_EQ(bytes[i], lut.to_byte(linear[i]));
+  }
+}
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include "trace.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+TEST(test_trace, writes_complete_events_per_thread) {
+  auto & recorder = render::TraceRecorder::instance();
+  recorder.enable();
+  {
+    render::ScopedTimer const timer("phase", "test", 7);
+  }
+  std::thread worker([] { render::ScopedTimer const timer("worker_phase", "test"); });
+  worker.join();
+
+  std::string const filename =
+      (std::filesystem::temp_directory_path() / "test_trace.json").string();
+  ASSERT_TRUE(recorder.write(filename));
+  std::ifstream in(filename);
+  std::string const text{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  std::filesystem::remove(filename);
+
+  EXPECT_TRUE(text.starts_with("{\"displayTimeUnit\": \"ms\", \"traceEvents\": ["));
+  EXPECT_NE(text.find("\"name\": \"phase\", \"cat\": \"test\", \"ph\": \"X\""), std::string::npos);
+  EXPECT_NE(text.find("\"args\": {\"value\": 7}"), std::string::npos);
+  EXPECT_NE(text.find("\"name\": \"worker_phase\""), std::string::npos);
+  EXPECT_NE(text.find("\"thread_name\""), std::string::npos);
+}
@@ -2,6 +2,8 @@
 
 #include "vector.hpp"
 
+#include <stdexcept>
+
 TEST(test_vector, magnitude_zero) {
     render::vector vec{0.0, 0.0, 0.0};
     EXPECT_EQ(vec.magnitude(), 0.0);
@@ -10,4 +12,21 @@ TEST(test_vector, magnitude_zero) {
 TEST(test_vector, magnitude_positive) {
     render::vector vec{3.0, 4.0, 0.0};
     EXPECT_EQ(vec.magnitude(), 5.0);
-}
\ No newline at end of file
+}
+
+// la aritmética del vector se evalúa en tiempo de compilación (todo está en la cabecera)
+TEST(test_vector, arithmetic_is_constexpr) {
+    constexpr render::vector u{1.0, 2.0, 3.0};
+    constexpr render::vector v{4.0, 5.0, 6.0};
+    static_assert(render::dot(u, v) == 32.0);
+    static_assert(render::cross(u, v).get_z() == -3.0);
+    static_assert((u + v - u * 2.0).get_y() == 3.0);
+    constexpr render::vector sum = [u, v] {
+        render::vector w = u;
+        w += v;
+        w /= 2.0;
+        return w;
+    }();
+    static_assert(sum[0] == 2.5 and sum.magnitude_squared() == 2.5 * 2.5 + 3.5 * 3.5 + 4.5 * 4.5);
+    EXPECT_THROW((void) u[3], std::out_of_range);
+}
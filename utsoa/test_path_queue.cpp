@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "path_queue.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+  // rellena cada columna del camino k con un valor derivado de 'id' distinto en cada columna
+  void fill_path(soa::PathQueue & q, std::size_t k, int id) {
+    double const v = id;
+    q.origin_x[k]  = static_cast<render::real>(v + 0.1);
+    q.origin_y[k]  = static_cast<render::real>(v + 0.2);
+    q.origin_z[k]  = static_cast<render::real>(v + 0.3);
+    q.dir_x[k]     = static_cast<render::real>(v + 0.4);
+    q.dir_y[k]     = static_cast<render::real>(v + 0.5);
+    q.dir_z[k]     = static_cast<render::real>(v + 0.6);
+    q.weight_r[k]  = v + 0.7;
+    q.weight_g[k]  = v + 0.8;
+    q.weight_b[k]  = v + 0.9;
+    q.pixel[k]     = static_cast<std::uint32_t>(id);
+    q.sample[k]    = static_cast<std::uint32_t>(id + 100);
+    q.dimension[k] = static_cast<std::uint32_t>(id + 200);
+    q.depth[k]     = id + 300;
+  }
+
+  // todas las columnas del camino k son las de fill_path(id)
+  void expect_path(soa::PathQueue const & q, std::size_t k, int id) {
+    double const v = id;
+    EXPECT_EQ(q.origin_x[k], static_cast<render::real>(v + 0.1)) << k;
+    EXPECT_EQ(q.origin_y[k], static_cast<render::real>(v + 0.2)) << k;
+    EXPECT_EQ(q.origin_z[k], static_cast<render::real>(v + 0.3)) << k;
+    EXPECT_EQ(q.dir_x[k], static_cast<render::real>(v + 0.4)) << k;
+    EXPECT_EQ(q.dir_y[k], static_cast<render::real>(v + 0.5)) << k;
+    EXPECT_EQ(q.dir_z[k], static_cast<render::real>(v + 0.6)) << k;
+    EXPECT_EQ(q.weight_r[k], v + 0.7) << k;
+    EXPECT_EQ(q.weight_g[k], v + 0.8) << k;
+    EXPECT_EQ(q.weight_b[k], v + 0.9) << k;
+    EXPECT_EQ(q.pixel[k], static_cast<std::uint32_t>(id)) << k;
+    EXPECT_EQ(q.sample[k], static_cast<std::uint32_t>(id + 100)) << k;
+    EXPECT_EQ(q.dimension[k], static_cast<std::uint32_t>(id + 200)) << k;
+    EXPECT_EQ(q.depth[k], id + 300) << k;
+  }
+
+}  // namespace
+
+// compact deja los supervivientes al principio, en su orden, cada uno con todas sus columnas
+TEST(test_path_queue, compact_keeps_survivor_columns_together) {
+  soa::PathQueue q(10);
+  q.size = 10;
+  for (std::size_t k = 0; k < q.size; ++k) {
+    fill_path(q, k, static_cast<int>(k));
+  }
+  std::vector<std::uint8_t> const alive{0, 1, 1, 0, 0, 1, 0, 1, 1, 0};
+  std::ranges::copy(alive, q.alive.begin());
+
+  q.compact();
+
+  std::vector<int> const survivors{1, 2, 5, 7, 8};
+  ASSERT_EQ(q.size, survivors.size());
+  for (std::size_t k = 0; k < survivors.size(); ++k) {
+    expect_path(q, k, survivors[k]);
+  }
+}
+
+TEST(test_path_queue, compact_without_survivors_empties_queue) {
+  soa::PathQueue q(4);
+  q.size = 4;
+  std::ranges::fill(q.alive, std::uint8_t{0});
+  q.compact();
+  EXPECT_EQ(q.size, 0U);
+}
+
+// gather copia los caminos en el orden dado con todas sus columnas
+TEST(test_path_queue, gather_moves_whole_paths) {
+  soa::PathQueue src(5);
+  src.size = 5;
+  for (std::size_t k = 0; k < src.size; ++k) {
+    fill_path(src, k, static_cast<int>(k));
+  }
+  soa::PathQueue dst(5);
+  std::vector<std::uint32_t> const order{3, 0, 4, 1, 2};
+
+  dst.gather(src, order);
+
+  ASSERT_EQ(dst.size, order.size());
+  for (std::size_t k = 0; k < order.size(); ++k) {
+    expect_path(dst, k, static_cast<int>(order[k]));
+  }
+}
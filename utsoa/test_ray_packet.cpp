@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include "config.hpp"
+#include "materials.hpp"
+#include "objects.hpp"
+#include "ray_packet.hpp"
+#include "sampler.hpp"
+#include "scene_parser.hpp"
+#include "soa_camera.hpp"
+#include "wavefront.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+  // en modo RENDER_FLOAT la etapa intersect recalcula en double los impactos con esferas
+  constexpr double T_TOLERANCE = render::SINGLE_PRECISION ? 1e-3 : 0.0;
+
+  // Escena de prueba: una esfera y un cilindro en la fila central y una esfera tapada por la
+  // primera (el cono del paquete la descarta por distancia)
+  struct PacketScene {
+    PacketScene() : matte(1), spheres(2), cylinders(1) {
+      spheres[0].center_x       = -4.0;
+      spheres[0].radius         = 3.0;
+      spheres[0].material_ptr   = &matte[0];
+      spheres[1].center_x       = -4.0;
+      spheres[1].center_z       = 10.0;
+      spheres[1].radius         = 3.0;
+      spheres[1].material_ptr   = &matte[0];
+      cylinders[0].center_x     = 4.0;
+      cylinders[0].radius       = 2.0;
+      cylinders[0].axis_y       = 1.0;
+      cylinders[0].height       = 4.0;
+      cylinders[0].material_ptr = &matte[0];
+    }
+
+    [[nodiscard]] SceneOutput output() {
+      return {matte, metal, refractive, spheres, cylinders};
+    }
+
+    std::vector<MatteMaterial> matte;
+    std::vector<MetalMaterial> metal;
+    std::vector<RefractiveMaterial> refractive;
+    std::vector<Sphere> spheres;
+    std::vector<Cylinder> cylinders;
+  };
+
+  // cola con 'samples' rayos de cámara por píxel de la fila central de una imagen de 'width' px,
+  // ya intersecados por la etapa intersect (con 'primary', por paquetes de PACKET_WIDTH)
+  soa::PathQueue traced_hits(SceneOutput const & scene, std::size_t width, std::uint32_t samples,
+                             bool primary) {
+    ConfigParams cfg;
+    cfg.image_width = static_cast<int>(width);
+    soa::CameraSOA const camera(cfg);
+    render::Sampler const sampler(cfg.sampler, static_cast<std::uint64_t>(cfg.ray_rng_seed));
+    int const height = cfg.get_image_height();
+    soa::WavefrontScene const wave_scene{
+      .cfg     = cfg,
+      .scene   = scene,
+      .view    = camera.viewport(width, static_cast<std::size_t>(height)),
+      .sampler = sampler,
+    };
+    soa::WavefrontTracer tracer(wave_scene, width * samples);
+    soa::RowAccumulator acc(width);
+    acc.reset();
+    tracer.generate(height / 2, samples, acc);
+    tracer.intersect(primary);
+    return tracer.queue();
+  }
+
+  // la cola sin impactos, como la deja la etapa intersect antes de probar los objetos
+  soa::PathQueue without_hits(soa::PathQueue queue) {
+    std::fill_n(queue.hit_t.begin(), queue.size, std::numeric_limits<render::real>::infinity());
+    std::fill_n(queue.hit_object.begin(), queue.size, nullptr);
+    std::fill_n(queue.hit_material.begin(), queue.size, nullptr);
+    return queue;
+  }
+
+  void expect_same_hit(soa::PathQueue const & q, soa::PathQueue const & reference,
+                       std::size_t k) {
+    ASSERT_EQ(q.hit_object[k], reference.hit_object[k]) << k;
+    if (q.hit_object[k] != nullptr) {
+      EXPECT_NEAR(q.hit_t[k], reference.hit_t[k], T_TOLERANCE * reference.hit_t[k]) << k;
+    }
+  }
+
+  // intersect_packet<N> sobre todos los paquetes completos de la cola; devuelve cuántos no
+  // divergen. Los que divergen no deben haber tocado sus carriles
+  template <std::size_t N>
+  std::size_t check_packets(soa::PathQueue const & reference, SceneOutput const & scene) {
+    soa::PathQueue q     = without_hits(reference);
+    std::size_t coherent = 0;
+    for (std::size_t begin = 0; begin + N <= q.size; begin += N) {
+      bool const traced = soa::intersect_packet<N>(q, begin, scene);
+      for (std::size_t k = begin; k < begin + N; ++k) {
+        if (traced) {
+          expect_same_hit(q, reference, k);
+        } else {
+          EXPECT_EQ(q.hit_object[k], nullptr) << k;
+          EXPECT_EQ(q.hit_t[k], std::numeric_limits<render::real>::infinity()) << k;
+        }
+      }
+      coherent += traced ? 1 : 0;
+    }
+    return coherent;
+  }
+
+}  // namespace
+
+// Con rayos de cámara cercanos (64 px de ancho, 4 muestras por píxel) ningún paquete diverge y
+// cada carril acaba con el mismo objeto y distancia que con la intersección rayo a rayo
+TEST(test_ray_packet, packets_match_per_ray_hits) {
+  PacketScene scene_data;
+  SceneOutput const scene        = scene_data.output();
+  soa::PathQueue const reference = traced_hits(scene, 64, 4, false);
+  ASSERT_EQ(reference.size, 256U);
+  // la fila ve la primera esfera, el cilindro y el fondo
+  EXPECT_GT(std::ranges::count(reference.hit_object, &scene_data.spheres[0]), 0);
+  EXPECT_GT(std::ranges::count(reference.hit_object, &scene_data.cylinders[0]), 0);
+  EXPECT_GT(std::ranges::count(reference.hit_object, nullptr), 0);
+
+  EXPECT_EQ(check_packets<4>(reference, scene), 64U);
+  EXPECT_EQ(check_packets<8>(reference, scene), 32U);
+  EXPECT_EQ(check_packets<16>(reference, scene), 16U);
+}
+
+// Con rayos muy separados (16 px para 90 grados, una muestra) los conos de 8 y 16 rayos son
+// demasiado abiertos: intersect_packet devuelve false sin tocar la cola, y la etapa intersect
+// traza esos paquetes rayo a rayo con el mismo resultado
+TEST(test_ray_packet, divergent_packets_fall_back_to_per_ray) {
+  PacketScene scene_data;
+  SceneOutput const scene        = scene_data.output();
+  soa::PathQueue const reference = traced_hits(scene, 16, 1, false);
+  ASSERT_EQ(reference.size, 16U);
+  EXPECT_GT(check_packets<4>(reference, scene), 0U);
+  EXPECT_EQ(check_packets<8>(reference, scene), 0U);
+  EXPECT_EQ(check_packets<16>(reference, scene), 0U);
+
+  soa::PathQueue const primary = traced_hits(scene, 16, 1, true);
+  ASSERT_EQ(primary.size, reference.size);
+  for (std::size_t k = 0; k < primary.size; ++k) {
+    expect_same_hit(primary, reference, k);
+  }
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include "materials.hpp"
+#include "objects.hpp"
+#include "path_queue.hpp"
+#include "ray_sort.hpp"
+#include "scene_parser.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+  // Escena de prueba: esfera de radio 5 en el origen y cámara en (0, 0, -10); la caja va de
+  // (-5, -5, -10) a (5, 5, 5)
+  struct SortScene {
+    SortScene() : matte(2), metal(1), refractive(1), spheres(1) {
+      spheres[0].radius       = 5.0;
+      spheres[0].material_ptr = &matte[0];
+    }
+
+    [[nodiscard]] SceneOutput output() {
+      return {matte, metal, refractive, spheres, cylinders};
+    }
+
+    std::vector<MatteMaterial> matte;
+    std::vector<MetalMaterial> metal;
+    std::vector<RefractiveMaterial> refractive;
+    std::vector<Sphere> spheres;
+    std::vector<Cylinder> cylinders;
+  };
+
+  render::vector const CAMERA{0.0, 0.0, -10.0};
+
+  // punto en el centro de la celda (cx, cy, cz) de la rejilla Morton de 32 celdas por eje
+  render::vector cell_center(soa::SceneBox const & box, double cx, double cy, double cz) {
+    render::vector const extent = box.max - box.min;
+    return {box.min.get_x() + (cx + 0.5) / 32.0 * extent.get_x(),
+            box.min.get_y() + (cy + 0.5) / 32.0 * extent.get_y(),
+            box.min.get_z() + (cz + 0.5) / 32.0 * extent.get_z()};
+  }
+
+  // camino k con un rayo propio (origen en una celda y dirección en un octante que dependen de
+  // k) y el resto de columnas derivadas de k
+  void fill_path(soa::PathQueue & q, std::size_t k, soa::SceneBox const & box) {
+    double const v             = static_cast<double>(k);
+    std::size_t const cell     = (k * 7) % 4;
+    render::vector const orig  = cell_center(box, static_cast<double>(cell), 0.0,
+                                             static_cast<double>(k % 3));
+    double const sx            = (k % 2) == 0 ? 1.0 : -1.0;
+    double const sz            = (k % 5) < 2 ? 1.0 : -1.0;
+    q.origin_x[k]              = static_cast<render::real>(orig.get_x());
+    q.origin_y[k]              = static_cast<render::real>(orig.get_y());
+    q.origin_z[k]              = static_cast<render::real>(orig.get_z());
+    q.dir_x[k]                 = static_cast<render::real>(sx * (0.5 + 0.01 * v));
+    q.dir_y[k]                 = static_cast<render::real>(0.25);
+    q.dir_z[k]                 = static_cast<render::real>(sz);
+    q.weight_r[k]              = v + 0.1;
+    q.weight_g[k]              = v + 0.2;
+    q.weight_b[k]              = v + 0.3;
+    q.pixel[k]                 = static_cast<std::uint32_t>(k);
+    q.sample[k]                = static_cast<std::uint32_t>(k + 100);
+    q.dimension[k]             = static_cast<std::uint32_t>(k + 200);
+    q.depth[k]                 = static_cast<int>(k) + 300;
+  }
+
+  std::uint32_t path_key(soa::PathQueue const & q, std::size_t k, soa::SceneBox const & box) {
+    return soa::direction_origin_key(render::vector{q.origin_x[k], q.origin_y[k], q.origin_z[k]},
+                                     render::vector{q.dir_x[k], q.dir_y[k], q.dir_z[k]}, box);
+  }
+
+}  // namespace
+
+// octante de la dirección en los 3 bits altos y Morton del origen (x, y, z de más a menos
+// significativo en cada grupo de 3 bits) en los 15 bajos
+TEST(test_ray_sort, direction_origin_key_layout) {
+  SortScene scene_data;
+  soa::SceneBox const box = soa::scene_box(scene_data.output(), CAMERA);
+  EXPECT_EQ(box.min.get_x(), -5.0);
+  EXPECT_EQ(box.min.get_y(), -5.0);
+  EXPECT_EQ(box.min.get_z(), -10.0);
+  EXPECT_EQ(box.max.get_x(), 5.0);
+  EXPECT_EQ(box.max.get_y(), 5.0);
+  EXPECT_EQ(box.max.get_z(), 5.0);
+
+  render::vector const forward{1.0, 1.0, 1.0};
+  EXPECT_EQ(soa::direction_origin_key(box.min, forward, box), 0U);
+  EXPECT_EQ(soa::direction_origin_key(box.max, forward, box), 0x7FFFU);
+  EXPECT_EQ(soa::direction_origin_key(cell_center(box, 1, 0, 0), forward, box), 0b100U);
+  EXPECT_EQ(soa::direction_origin_key(cell_center(box, 0, 1, 0), forward, box), 0b010U);
+  EXPECT_EQ(soa::direction_origin_key(cell_center(box, 0, 0, 1), forward, box), 0b001U);
+  EXPECT_EQ(soa::direction_origin_key(cell_center(box, 2, 3, 1), forward, box), 0b110'011U);
+
+  EXPECT_EQ(soa::direction_origin_key(box.min, {-1.0, 1.0, 1.0}, box), 1U << 15U);
+  EXPECT_EQ(soa::direction_origin_key(box.min, {1.0, -1.0, 1.0}, box), 2U << 15U);
+  EXPECT_EQ(soa::direction_origin_key(box.min, {1.0, 1.0, -1.0}, box), 4U << 15U);
+  EXPECT_EQ(soa::direction_origin_key(box.max, {-1.0, -1.0, -1.0}, box), 0x3FFFFU);
+}
+
+// 0 para el fondo; tipo de material en los bits altos y posición en su vector en los bajos
+TEST(test_ray_sort, material_key_layout) {
+  SortScene scene_data;
+  SceneOutput const scene = scene_data.output();
+  EXPECT_EQ(soa::material_key(nullptr, scene), 0U);
+  EXPECT_EQ(soa::material_key(&scene_data.matte[0], scene), 1U << 16U);
+  EXPECT_EQ(soa::material_key(&scene_data.matte[1], scene), (1U << 16U) | 1U);
+  EXPECT_EQ(soa::material_key(&scene_data.metal[0], scene), 2U << 16U);
+  EXPECT_EQ(soa::material_key(&scene_data.refractive[0], scene), 3U << 16U);
+}
+
+// sort_for_intersect mueve cada camino entero (todas sus columnas) y deja la cola ordenada por
+// clave, con los caminos de la misma clave en su orden original (radix estable)
+TEST(test_ray_sort, sort_for_intersect_moves_whole_paths_in_key_order) {
+  SortScene scene_data;
+  SceneOutput const scene = scene_data.output();
+  soa::SceneBox const box = soa::scene_box(scene, CAMERA);
+  constexpr std::size_t n = 40;
+  soa::PathQueue q(n);
+  q.size = n;
+  for (std::size_t k = 0; k < n; ++k) {
+    fill_path(q, k, box);
+  }
+  soa::PathQueue const original = q;
+  soa::RaySorter sorter(scene, CAMERA, n);
+
+  // la segunda pasada encuentra la cola ya ordenada y no la cambia
+  for (int pass = 0; pass < 2; ++pass) {
+    sorter.sort_for_intersect(q);
+    ASSERT_EQ(q.size, n);
+    std::vector<bool> seen(n, false);
+    for (std::size_t k = 0; k < n; ++k) {
+      std::size_t const from = q.pixel[k];
+      ASSERT_LT(from, n);
+      EXPECT_FALSE(seen[from]) << k;
+      seen[from] = true;
+      EXPECT_EQ(q.origin_x[k], original.origin_x[from]) << k;
+      EXPECT_EQ(q.origin_y[k], original.origin_y[from]) << k;
+      EXPECT_EQ(q.origin_z[k], original.origin_z[from]) << k;
+      EXPECT_EQ(q.dir_x[k], original.dir_x[from]) << k;
+      EXPECT_EQ(q.dir_y[k], original.dir_y[from]) << k;
+      EXPECT_EQ(q.dir_z[k], original.dir_z[from]) << k;
+      EXPECT_EQ(q.weight_r[k], original.weight_r[from]) << k;
+      EXPECT_EQ(q.weight_g[k], original.weight_g[from]) << k;
+      EXPECT_EQ(q.weight_b[k], original.weight_b[from]) << k;
+      EXPECT_EQ(q.sample[k], original.sample[from]) << k;
+      EXPECT_EQ(q.dimension[k], original.dimension[from]) << k;
+      EXPECT_EQ(q.depth[k], original.depth[from]) << k;
+      if (k > 0) {
+        std::uint32_t const prev = path_key(q, k - 1, box);
+        std::uint32_t const key  = path_key(q, k, box);
+        EXPECT_LE(prev, key) << k;
+        if (prev == key) {
+          EXPECT_LT(q.pixel[k - 1], q.pixel[k]) << k;
+        }
+      }
+    }
+  }
+}
+
+// bin_by_material devuelve una permutación de las posiciones agrupada por material, estable
+// dentro de cada grupo y con el fondo al principio, sin mover la cola
+TEST(test_ray_sort, bin_by_material_groups_positions) {
+  SortScene scene_data;
+  SceneOutput const scene = scene_data.output();
+  std::vector<render::MaterialBase const *> const materials{
+    &scene_data.metal[0], nullptr, &scene_data.matte[1], &scene_data.matte[0],
+    &scene_data.refractive[0], &scene_data.matte[1], nullptr, &scene_data.metal[0],
+    &scene_data.matte[0], &scene_data.refractive[0],
+  };
+  soa::PathQueue q(materials.size());
+  q.size = materials.size();
+  std::ranges::copy(materials, q.hit_material.begin());
+  soa::RaySorter sorter(scene, CAMERA, q.size);
+
+  std::span<std::uint32_t const> const order = sorter.bin_by_material(q);
+
+  std::vector<std::uint32_t> const expected{1, 6, 3, 8, 2, 5, 0, 7, 4, 9};
+  EXPECT_TRUE(std::ranges::equal(order, expected));
+  EXPECT_TRUE(std::ranges::equal(std::span(q.hit_material.data(), q.size), materials));
+}
+
+// si todos los caminos comparten material el orden de la cola ya sirve
+TEST(test_ray_sort, bin_by_material_single_material_keeps_queue_order) {
+  SortScene scene_data;
+  SceneOutput const scene = scene_data.output();
+  soa::PathQueue q(6);
+  q.size = 6;
+  std::ranges::fill(q.hit_material, &scene_data.matte[1]);
+  soa::RaySorter sorter(scene, CAMERA, q.size);
+  EXPECT_TRUE(sorter.bin_by_material(q).empty());
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include "alloc_counter.hpp"
+#include "config.hpp"
+#include "cost_map.hpp"
+#include "materials.hpp"
+#include "objects.hpp"
+#include "render_soa.hpp"
+#include "render_stats.hpp"
+#include "scene_parser.hpp"
+#include "soa_camera.hpp"
+#include "soa_image.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// render_scene completo (olas de caminos, dispersión por lotes y mapa de coste) con el perfil por
+// objeto activo: la fase de render no debe asignar memoria dinámica
+TEST(test_render_soa, render_phase_does_not_allocate) {
+  if (!render::allocation_counting_enabled()) {
+    GTEST_SKIP() << "compilado con ENABLE_ALLOC_COUNTING=OFF";
+  }
+  std::vector<MatteMaterial> matte(1);
+  std::vector<MetalMaterial> metal(1);
+  std::vector<RefractiveMaterial> refractive(1);
+  refractive[0].refractive_index = 1.5;
+  std::vector<Sphere> spheres(2);
+  spheres[0].radius       = 1.0;
+  spheres[0].material_ptr = &matte[0];
+  spheres[0].source_line  = 1;
+  spheres[1].center_x     = -2.0;
+  spheres[1].radius       = 0.5;
+  spheres[1].material_ptr = &refractive[0];
+  spheres[1].source_line  = 2;
+  std::vector<Cylinder> cylinders(1);
+  cylinders[0].center_x     = 2.0;
+  cylinders[0].radius       = 0.5;
+  cylinders[0].axis_y       = 2.0;
+  cylinders[0].material_ptr = &metal[0];
+  cylinders[0].source_line  = 3;
+  SceneOutput const scene{matte, metal, refractive, spheres, cylinders};
+
+  ConfigParams config;
+  config.image_width       = 32;
+  config.samples_per_pixel = 4;
+  int const height         = config.get_image_height();
+  soa::CameraSOA const camera(config);
+  SOAImage image(config.image_width, height);
+  render::CostMap cost_map(config.image_width, height, render::CostMap::Metric::TESTS);
+
+  render::AllocationProfile::instance().enable();
+  render::enable_object_profile(3);
+  std::uint64_t const primary_rays =
+      soa::render_scene(config, scene, camera, {.image = image, .cost_map = &cost_map});
+  render::object_profile_active = false;
+
+  EXPECT_EQ(primary_rays, 32U * 18U * 4U);
+  EXPECT_EQ(render::AllocationProfile::instance().category_total("render").allocations, 0U);
+}
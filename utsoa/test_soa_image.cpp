@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+
+#include "soa_image.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+TEST(test_soa_image, writes_ppm) {
+  SOAImage image(2, 1);
+  image.setPixel(0, 1, RGBColor(1.0, 1.0, 1.0), 2.2);
+  std::string const filename =
+      (std::filesystem::temp_directory_path() / "test_soa_image.ppm").string();
+  ASSERT_TRUE(image.write_ppm(filename));
+  std::ifstream in(filename, std::ios::binary);
+  std::string const data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  std::filesystem::remove(filename);
+  EXPECT_EQ(data, std::string("P6\n2 1\n255\n") + std::string(3, '\0') + std::string(3, '\xff'));
+}
+
+// ni un directorio inexistente ni un dispositivo lleno dejan pasar el error
+TEST(test_soa_image, reports_write_errors) {
+  SOAImage const image(64, 64);
+  std::filesystem::path const missing =
+      std::filesystem::temp_directory_path() / "test_soa_image_missing" / "out.ppm";
+  EXPECT_FALSE(image.write_ppm(missing.string()));
+  if (std::filesystem::exists("/dev/full")) {
+    EXPECT_FALSE(image.write_ppm("/dev/full"));
+  }
+}
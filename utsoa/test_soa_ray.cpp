@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "hittable.hpp"
+#include "materials.hpp"
+#include "objects.hpp"
+#include "ray_packet.hpp"
+#include "soa_ray.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+namespace {
+
+  // impacto más cercano con las funciones de intersección de SOA
+  std::optional<double> soa_hit_t(ray::Ray const & r, Sphere const & sph, Cylinder const & cyl) {
+    ray::IntersectionParams const params{.t_min = ray::MIN_DISTANCE,
+                                         .t_max = std::numeric_limits<double>::infinity()};
+    auto const sphere_hit =
+        ray::hit_sphere(r, {sph.center_x, sph.center_y, sph.center_z}, sph.radius, params);
+    auto const cylinder_hit = ray::hit_cylinder(r, soa::cylinder_params(cyl), params);
+    if (sphere_hit and cylinder_hit) {
+      return std::min(sphere_hit->t, cylinder_hit->t);
+    }
+    if (sphere_hit) {
+      return sphere_hit->t;
+    }
+    if (cylinder_hit) {
+      return cylinder_hit->t;
+    }
+    return std::nullopt;
+  }
+
+}  // namespace
+
+// Los dos backends ven la escena de ejemplo (archivos_ejemplo/scene_valid.txt) igual: los rayos
+// primarios desde la cámara de config_valid.txt impactan en los mismos objetos a la misma
+// distancia con render::hittable_list (AOS) y con ray::hit_sphere/hit_cylinder (SOA)
+TEST(test_soa_ray, agrees_with_common_hittable_on_example_scene) {
+  MatteMaterial matte;
+  Sphere sphere;
+  sphere.radius       = 1.0;
+  sphere.material_ptr = &matte;
+  Cylinder cylinder;
+  cylinder.center_x     = 2.0;
+  cylinder.radius       = 0.5;
+  cylinder.axis_y       = 2.0;
+  cylinder.material_ptr = &matte;
+  render::hittable_list world;
+  world.add(&sphere);
+  world.add(&cylinder);
+
+  render::point_vector const camera(0.0, 0.0, 5.0);
+  int hits = 0;
+  for (int j = 0; j <= 40; ++j) {
+    for (int i = 0; i <= 60; ++i) {
+      render::point_vector const target(-3.0 + 0.1 * i, -2.0 + 0.1 * j, 0.0);
+      ray::Ray const r(camera, render::unit_vector(target - camera));
+      render::hit_record rec;
+      bool const aos_hit                = world.hit(r, ray::MIN_DISTANCE, 1e9, rec);
+      std::optional<double> const soa_t = soa_hit_t(r, sphere, cylinder);
+      ASSERT_EQ(aos_hit, soa_t.has_value()) << i << ", " << j;
+      if (aos_hit) {
+        EXPECT_NEAR(rec.t, *soa_t, 1e-9) << i << ", " << j;
+        ++hits;
+      }
+    }
+  }
+  // la escena ocupa una parte de la imagen, no toda
+  EXPECT_GT(hits, 0);
+  EXPECT_LT(hits, 41 * 61 / 2);
+}
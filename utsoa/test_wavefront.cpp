@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include "config.hpp"
+#include "materials.hpp"
+#include "objects.hpp"
+#include "sampler.hpp"
+#include "scene_parser.hpp"
+#include "soa_camera.hpp"
+#include "soa_color.hpp"
+#include "soa_ray.hpp"
+#include "wavefront.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+  // fila central de una imagen de 20 px de ancho (más de un paquete de rayos y un resto)
+  constexpr std::size_t WIDTH     = 20;
+  constexpr std::uint32_t SAMPLES = 3;
+
+  ConfigParams test_config() {
+    ConfigParams cfg;
+    cfg.image_width = static_cast<int>(WIDTH);
+    return cfg;
+  }
+
+  int middle_row(ConfigParams const & cfg) { return cfg.get_image_height() / 2; }
+
+  ray::Ray queue_ray(soa::PathQueue const & q, std::size_t k) {
+    return {
+      render::vector{q.origin_x[k], q.origin_y[k], q.origin_z[k]},
+      render::vector{   q.dir_x[k],    q.dir_y[k],    q.dir_z[k]}
+    };
+  }
+
+}  // namespace
+
+// Los rayos de cámara de una fila que atraviesa una esfera dan, por paquetes y rayo a rayo, el
+// mismo impacto (t, normal y objeto) que ray::hit_sphere
+TEST(test_wavefront, sphere_hits_match_hit_sphere) {
+  std::vector<MatteMaterial> matte(1);
+  std::vector<MetalMaterial> metal;
+  std::vector<RefractiveMaterial> refractive;
+  std::vector<Sphere> spheres(1);
+  spheres[0].radius       = 4.0;
+  spheres[0].material_ptr = &matte[0];
+  std::vector<Cylinder> cylinders;
+  SceneOutput const scene{matte, metal, refractive, spheres, cylinders};
+
+  ConfigParams const cfg = test_config();
+  soa::CameraSOA const camera(cfg);
+  render::Sampler const sampler(cfg.sampler, static_cast<std::uint64_t>(cfg.ray_rng_seed));
+  soa::WavefrontScene const wave_scene{
+    .cfg     = cfg,
+    .scene   = scene,
+    .view    = camera.viewport(WIDTH, static_cast<std::size_t>(cfg.get_image_height())),
+    .sampler = sampler,
+  };
+  soa::WavefrontTracer tracer(wave_scene, WIDTH * SAMPLES);
+  soa::RowAccumulator acc(WIDTH);
+  acc.reset();
+  tracer.generate(middle_row(cfg), SAMPLES, acc);
+  tracer.intersect(true);
+
+  soa::PathQueue const & q = tracer.queue();
+  ASSERT_EQ(q.size, WIDTH * SAMPLES);
+  ray::IntersectionParams const params{.t_min = ray::MIN_DISTANCE,
+                                       .t_max = std::numeric_limits<double>::infinity()};
+  std::size_t hits = 0;
+  for (std::size_t k = 0; k < q.size; ++k) {
+    auto const rec = ray::hit_sphere(queue_ray(q, k), {0.0, 0.0, 0.0}, 4.0, params);
+    ASSERT_EQ(q.hit_object[k] != nullptr, rec.has_value()) << k;
+    if (!rec) {
+      EXPECT_EQ(q.hit_material[k], nullptr) << k;
+      continue;
+    }
+    ++hits;
+    EXPECT_EQ(q.hit_object[k], &spheres[0]) << k;
+    EXPECT_EQ(q.hit_material[k], &matte[0]) << k;
+    EXPECT_TRUE(rec->front_face) << k;
+    EXPECT_NEAR(q.hit_t[k], rec->t, 1e-4) << k;
+    EXPECT_NEAR(q.normal_x[k], rec->normal.get_x(), 1e-4) << k;
+    EXPECT_NEAR(q.normal_y[k], rec->normal.get_y(), 1e-4) << k;
+    EXPECT_NEAR(q.normal_z[k], rec->normal.get_z(), 1e-4) << k;
+  }
+  // la esfera tapa el centro de la fila, no los bordes
+  EXPECT_GT(hits, 0U);
+  EXPECT_LT(hits, q.size);
+}
+
+// Sin objetos todos los caminos van al fondo: cada píxel suma el color del fondo en la
+// dirección de cada una de sus muestras y termina con un solo segmento por muestra
+TEST(test_wavefront, misses_accumulate_background_color) {
+  std::vector<MatteMaterial> matte;
+  std::vector<MetalMaterial> metal;
+  std::vector<RefractiveMaterial> refractive;
+  std::vector<Sphere> spheres;
+  std::vector<Cylinder> cylinders;
+  SceneOutput const scene{matte, metal, refractive, spheres, cylinders};
+
+  ConfigParams const cfg = test_config();
+  soa::CameraSOA const camera(cfg);
+  render::Sampler const sampler(cfg.sampler, static_cast<std::uint64_t>(cfg.ray_rng_seed));
+  soa::WavefrontScene const wave_scene{
+    .cfg     = cfg,
+    .scene   = scene,
+    .view    = camera.viewport(WIDTH, static_cast<std::size_t>(cfg.get_image_height())),
+    .sampler = sampler,
+  };
+  soa::WavefrontTracer tracer(wave_scene, WIDTH * SAMPLES);
+  soa::RowAccumulator acc(WIDTH);
+  acc.reset();
+  tracer.generate(middle_row(cfg), SAMPLES, acc);
+
+  color::Color const light{cfg.background_light_color_r, cfg.background_light_color_g,
+                           cfg.background_light_color_b};
+  color::Color const dark{cfg.background_dark_color_r, cfg.background_dark_color_g,
+                          cfg.background_dark_color_b};
+  std::vector<color::Color> expected(WIDTH);
+  soa::PathQueue const & q = tracer.queue();
+  for (std::size_t k = 0; k < q.size; ++k) {
+    double const dir_y   = render::unit_vector(queue_ray(q, k).dir).get_y();
+    color::Color const c = color::background_color(dir_y, light, dark);
+    expected[q.pixel[k]].r += c.r;
+    expected[q.pixel[k]].g += c.g;
+    expected[q.pixel[k]].b += c.b;
+  }
+
+  tracer.trace(acc);
+
+  EXPECT_EQ(tracer.queue().size, 0U);
+  for (std::size_t i = 0; i < WIDTH; ++i) {
+    EXPECT_EQ(acc.taken[i], SAMPLES) << i;
+    EXPECT_EQ(acc.segments[i], SAMPLES) << i;
+    EXPECT_NEAR(acc.r[i], expected[i].r, 1e-9) << i;
+    EXPECT_NEAR(acc.g[i], expected[i].g, 1e-9) << i;
+    EXPECT_NEAR(acc.b[i], expected[i].b, 1e-9) << i;
+  }
+}